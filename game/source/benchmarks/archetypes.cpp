@@ -0,0 +1,102 @@
+#include <benchmarks.hpp>
+
+#include <spark/ecs/archetype_registry.hpp>
+#include <spark/ecs/registry.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+
+    struct Velocity {
+        float x, y, z;
+    };
+
+    struct Acceleration {
+        float x, y, z;
+    };
+
+    struct Mass {
+        float value;
+    };
+
+    struct Drag {
+        float value;
+    };
+
+    struct Lifetime {
+        float remaining;
+    };
+
+    void integrate(Position& position, Velocity& velocity, const Acceleration& acceleration, const Mass& mass, const Drag& drag, Lifetime& lifetime) {
+        float scale = 1.0f / mass.value;
+
+        velocity.x = (velocity.x + acceleration.x * scale) * drag.value;
+        velocity.y = (velocity.y + acceleration.y * scale) * drag.value;
+        velocity.z = (velocity.z + acceleration.z * scale) * drag.value;
+
+        position.x += velocity.x;
+        position.y += velocity.y;
+        position.z += velocity.z;
+
+        lifetime.remaining -= 1.0f;
+    }
+
+    template <typename R>
+    void populate(R& registry, int count) {
+        for (int i = 0; i < count; ++i) {
+            auto entity = registry.create();
+
+            registry.template emplace<Position>(entity, float(i), 0.0f, 0.0f);
+            registry.template emplace<Velocity>(entity, 1.0f, 0.0f, 0.0f);
+            registry.template emplace<Acceleration>(entity, 0.0f, -9.8f, 0.0f);
+            registry.template emplace<Mass>(entity, 1.0f + float(i % 4));
+            registry.template emplace<Drag>(entity, 0.99f);
+            registry.template emplace<Lifetime>(entity, 100.0f);
+        }
+    }
+}
+
+void test_spark_archetypes() {
+    using clock = std::chrono::high_resolution_clock;
+
+    constexpr int N = 1'000'000;
+    constexpr int iterations = 10;
+
+    // --- Sparse set registry, view over six components ---
+    {
+        spark::registry registry;
+        populate(registry, N);
+
+        auto start = clock::now();
+
+        for (int i = 0; i < iterations; ++i) {
+            registry.view<Position, Velocity, Acceleration, Mass, Drag, Lifetime>().each(integrate);
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark registry view x" << iterations << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    // --- Archetype registry, chunk iteration over six components ---
+    {
+        spark::archetype_registry registry;
+        populate(registry, N);
+
+        auto start = clock::now();
+
+        for (int i = 0; i < iterations; ++i) {
+            registry.each<Position, Velocity, Acceleration, Mass, Drag, Lifetime>(integrate);
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark archetype_registry each x" << iterations << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+}
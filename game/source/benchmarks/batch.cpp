@@ -0,0 +1,94 @@
+#include <benchmarks.hpp>
+
+#include <spark/ecs/registry.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+
+    struct Velocity {
+        float x, y, z;
+    };
+
+    struct ColumnPosition {
+        float x, y, z;
+    };
+
+    struct ColumnVelocity {
+        float x, y, z;
+    };
+}
+
+template <>
+struct spark::component_traits<ColumnPosition> {
+    static constexpr bool track_changes = false;
+
+    using fields = soa_fields<&ColumnPosition::x, &ColumnPosition::y, &ColumnPosition::z>;
+};
+
+template <>
+struct spark::component_traits<ColumnVelocity> {
+    static constexpr bool track_changes = false;
+
+    using fields = soa_fields<&ColumnVelocity::x, &ColumnVelocity::y, &ColumnVelocity::z>;
+};
+
+void test_spark_batch() {
+    using clock = std::chrono::high_resolution_clock;
+
+    constexpr int N = 1'000'000;
+    constexpr int iterations = 10;
+    constexpr float dt = 1.0f / 60.0f;
+
+    spark::registry registry;
+
+    for (int i = 0; i < N; ++i) {
+        auto entity = registry.create();
+
+        registry.emplace<Position>(entity, float(i), 0.0f, 0.0f);
+        registry.emplace<Velocity>(entity, 1.0f, 2.0f, 3.0f);
+
+        registry.emplace<ColumnPosition>(entity, float(i), 0.0f, 0.0f);
+        registry.emplace<ColumnVelocity>(entity, 1.0f, 2.0f, 3.0f);
+    }
+
+    // --- Per-entity each over plain components ---
+    {
+        auto start = clock::now();
+
+        for (int i = 0; i < iterations; ++i) {
+            registry.view<Position, Velocity>().each([](Position& position, const Velocity& velocity) {
+                position.x += velocity.x * dt;
+                position.y += velocity.y * dt;
+                position.z += velocity.z * dt;
+            });
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark view each x" << iterations << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    // --- Batched each over column components ---
+    {
+        auto start = clock::now();
+
+        for (int i = 0; i < iterations; ++i) {
+            registry.view<ColumnPosition, ColumnVelocity>().each_batch([](auto& batch) {
+                batch.template get<&ColumnPosition::x>() += batch.template read<&ColumnVelocity::x>() * dt;
+                batch.template get<&ColumnPosition::y>() += batch.template read<&ColumnVelocity::y>() * dt;
+                batch.template get<&ColumnPosition::z>() += batch.template read<&ColumnVelocity::z>() * dt;
+            });
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark view each_batch<" << spark::simd_width<float> << "> x" << iterations << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+}
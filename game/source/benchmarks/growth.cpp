@@ -0,0 +1,126 @@
+#include <benchmarks.hpp>
+
+#include <spark/events/dispatcher.hpp>
+#include <spark/types/allocator.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/sparse_set.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+
+    // @brief same layout as Position, but its move constructor keeps it off the byte copy path
+    struct MovablePosition {
+        float x, y, z;
+
+        MovablePosition(float px, float py, float pz) : x(px), y(py), z(pz) {}
+        MovablePosition(MovablePosition&& other) noexcept : x(other.x), y(other.y), z(other.z) {}
+        MovablePosition& operator=(MovablePosition&& other) noexcept = default;
+    };
+
+    // @brief trivially copyable, but its default member initializer makes resize write every element
+    struct Health {
+        float value = 100.0f;
+    };
+
+    struct DamageEvent {
+        float damage;
+    };
+
+    float received = 0.0f;
+
+    void receiveDamage(const DamageEvent& event) {
+        received += event.damage;
+    }
+
+    template <typename T>
+    double time_sparse_set_growth(int count) {
+        using clock = std::chrono::high_resolution_clock;
+
+        auto start = clock::now();
+
+        spark::sparse_set<T> set;
+
+        for (int i = 0; i < count; ++i) {
+            set.insert(spark::uint64(i), float(i), 0.0f, 0.0f);
+        }
+
+        auto end = clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    template <typename D>
+    double time_dispatcher_queue(D& dispatcher, int count) {
+        using clock = std::chrono::high_resolution_clock;
+
+        auto start = clock::now();
+
+        for (int i = 0; i < count; ++i) {
+            dispatcher.template enqueue<DamageEvent>(1.0f);
+        }
+
+        dispatcher.update();
+
+        auto end = clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+}
+
+void test_spark_growth() {
+    using clock = std::chrono::high_resolution_clock;
+
+    constexpr int N = 10'000'000;
+
+    // --- sparse_set growth, byte copy against per-element moves ---
+    std::cout << "[Spark sparse_set growth, trivially relocatable] " << time_sparse_set_growth<Position>(N) << " ms\n";
+    std::cout << "[Spark sparse_set growth, move constructed] " << time_sparse_set_growth<MovablePosition>(N) << " ms\n";
+
+    // --- dispatcher queue growth, heap against a linear arena ---
+    {
+        spark::dispatcher dispatcher;
+        dispatcher.sink<DamageEvent>().connect<receiveDamage>();
+
+        std::cout << "[Spark dispatcher queue, heap] " << time_dispatcher_queue(dispatcher, N) << " ms\n";
+    }
+
+    {
+        spark::linear_arena arena(sizeof(DamageEvent) * N * 2);
+        spark::dispatcher<spark::uint64, spark::arena_allocator> dispatcher{spark::arena_allocator(arena)};
+        dispatcher.sink<DamageEvent>().connect<receiveDamage>();
+
+        std::cout << "[Spark dispatcher queue, linear arena] " << time_dispatcher_queue(dispatcher, N) << " ms\n";
+
+        arena.reset();
+    }
+
+    // --- resize against resize_uninitialized ---
+    {
+        spark::list<Health> health;
+
+        auto start = clock::now();
+        health.resize(N);
+        auto end = clock::now();
+
+        std::cout << "[Spark list resize] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    {
+        spark::list<Health> health;
+
+        auto start = clock::now();
+        health.resize_uninitialized(N);
+        auto end = clock::now();
+
+        std::cout << "[Spark list resize_uninitialized] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+}
@@ -0,0 +1,111 @@
+#include <benchmarks.hpp>
+
+#include <spark/types/hash_map.hpp>
+#include <spark/types/list.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+namespace {
+    // @brief times one pass of an operation over every key
+    template <typename F>
+    void time_pass(const char* label, F&& pass) {
+        using clock = std::chrono::high_resolution_clock;
+
+        auto start = clock::now();
+        pass();
+        auto end = clock::now();
+
+        std::cout << label << " "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+}
+
+void test_spark_hash_map() {
+    constexpr int N = 1'000'000;
+
+    // --- Sparse 64-bit keys, such as network ids ---
+    spark::list<std::uint64_t> keys;
+    keys.reserve(N);
+
+    std::mt19937_64 random(42);
+
+    for (int i = 0; i < N; ++i) {
+        keys.emplace(random());
+    }
+
+    std::uint64_t found = 0;
+
+    {
+        spark::hash_map<std::uint64_t, std::uint64_t> map;
+
+        time_pass("[Spark hash_map insert]", [&] {
+            for (std::uint64_t key : keys) {
+                map.emplace(key, key);
+            }
+        });
+
+        time_pass("[Spark hash_map lookup]", [&] {
+            for (std::uint64_t key : keys) {
+                found += *map.find(key);
+            }
+        });
+
+        time_pass("[Spark hash_map erase]", [&] {
+            for (std::uint64_t key : keys) {
+                map.remove(key);
+            }
+        });
+    }
+
+    {
+        std::unordered_map<std::uint64_t, std::uint64_t> map;
+
+        time_pass("[std::unordered_map insert]", [&] {
+            for (std::uint64_t key : keys) {
+                map.emplace(key, key);
+            }
+        });
+
+        time_pass("[std::unordered_map lookup]", [&] {
+            for (std::uint64_t key : keys) {
+                found += map.find(key)->second;
+            }
+        });
+
+        time_pass("[std::unordered_map erase]", [&] {
+            for (std::uint64_t key : keys) {
+                map.erase(key);
+            }
+        });
+    }
+
+    // --- Reserved up front ---
+    {
+        spark::hash_map<std::uint64_t, std::uint64_t> map;
+        map.reserve(N);
+
+        time_pass("[Spark hash_map insert, reserved]", [&] {
+            for (std::uint64_t key : keys) {
+                map.emplace(key, key);
+            }
+        });
+    }
+
+    {
+        std::unordered_map<std::uint64_t, std::uint64_t> map;
+        map.reserve(N);
+
+        time_pass("[std::unordered_map insert, reserved]", [&] {
+            for (std::uint64_t key : keys) {
+                map.emplace(key, key);
+            }
+        });
+    }
+
+    std::cout << "[checksum] " << found << "\n";
+}
@@ -0,0 +1,127 @@
+#include <benchmarks.hpp>
+
+#include <spark/ecs/hierarchy.hpp>
+#include <spark/ecs/registry.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+    using entity_type = spark::entity<spark::uint64>;
+
+    // @brief checks that each visits every parent before its children
+    bool visits_parents_first(spark::hierarchy<>& tree, spark::uint64 count) {
+        spark::list<bool> visited;
+        visited.resize(count, false);
+
+        bool ordered = true;
+
+        tree.each([&](entity_type entity, entity_type parent) {
+            if (parent != entity_type() && !visited[parent.id()]) {
+                ordered = false;
+            }
+
+            visited[entity.id()] = true;
+        });
+
+        return ordered;
+    }
+
+    // @brief builds roots r0 and r1, a child of r1 and a detached root, so removing r0 swaps the child in front of r1
+    bool check_removal(bool destroy) {
+        spark::registry registry;
+        spark::hierarchy tree(registry);
+
+        entity_type r0 = registry.create();
+        entity_type r1 = registry.create();
+        entity_type child = registry.create();
+        entity_type detached = registry.create();
+
+        tree.attach(detached, r0);
+        tree.detach(detached);
+        tree.attach(child, r1);
+        tree.sort();
+
+        if (destroy) {
+            registry.destroy(r0);
+        }
+        else {
+            registry.remove<spark::relationship<>>(r0);
+        }
+
+        return visits_parents_first(tree, 4);
+    }
+}
+
+void test_spark_hierarchy() {
+    using clock = std::chrono::high_resolution_clock;
+
+    constexpr int N = 1'000'000;
+    constexpr int fanout = 8;
+
+    spark::registry registry;
+    spark::hierarchy tree(registry);
+
+    spark::list<entity_type> entities;
+    entities.reserve(N);
+
+    for (int i = 0; i < N; ++i) {
+        entities.emplace(registry.create());
+
+        if (i > 0) {
+            tree.attach(entities[spark::uint64(i)], entities[spark::uint64((i - 1) / fanout)]);
+        }
+    }
+
+    // --- Depth sort after building ---
+    {
+        auto start = clock::now();
+        tree.sort();
+        auto end = clock::now();
+
+        std::cout << "[Spark hierarchy sort] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    // --- Parent-first walk ---
+    {
+        std::size_t roots = 0;
+
+        auto start = clock::now();
+
+        tree.each([&](entity_type, entity_type parent) {
+            roots += parent == entity_type();
+        });
+
+        auto end = clock::now();
+
+        std::cout << "[Spark hierarchy each] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms (" << roots << " roots)\n";
+    }
+
+    // --- Depth sort after moving a subtree ---
+    {
+        entity_type leaf = entities[1];
+
+        while (tree.get(leaf).firstChild != entity_type()) {
+            leaf = tree.get(leaf).firstChild;
+        }
+
+        tree.attach(entities[2], leaf);
+
+        auto start = clock::now();
+        tree.sort();
+        auto end = clock::now();
+
+        std::cout << "[Spark hierarchy sort after moving a subtree] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    // --- Ordering after removals ---
+    std::cout << "[Spark hierarchy order after destroy] " << (check_removal(true) ? "ok" : "FAILED") << "\n";
+    std::cout << "[Spark hierarchy order after remove] " << (check_removal(false) ? "ok" : "FAILED") << "\n";
+    std::cout << "[Spark hierarchy order after building] " << (visits_parents_first(tree, N) ? "ok" : "FAILED") << "\n";
+}
@@ -0,0 +1,85 @@
+#include <benchmarks.hpp>
+
+#include <spark/ecs/registry.hpp>
+#include <spark/threading/job_system.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+
+    struct Velocity {
+        float x, y, z;
+    };
+
+    void integrate(Position& position, const Velocity& velocity) {
+        constexpr float dt = 1.0f / 60.0f;
+
+        // a little extra arithmetic so the loop is not purely bandwidth bound
+        for (int i = 0; i < 8; ++i) {
+            position.x += velocity.x * dt;
+            position.y += velocity.y * dt;
+            position.z += velocity.z * dt;
+        }
+    }
+}
+
+void test_spark_parallel_view() {
+    using clock = std::chrono::high_resolution_clock;
+
+    constexpr int N = 1'000'000;
+    constexpr int frames = 20;
+
+    spark::registry registry;
+
+    for (int i = 0; i < N; ++i) {
+        auto entity = registry.create();
+
+        registry.emplace<Position>(entity, 0.0f, 0.0f, 0.0f);
+
+        if (i % 4 != 0) {
+            registry.emplace<Velocity>(entity, 1.0f, 2.0f, 3.0f);
+        }
+    }
+
+    // --- Single-threaded baseline ---
+    {
+        auto start = clock::now();
+
+        for (int frame = 0; frame < frames; ++frame) {
+            registry.view<Position, Velocity>().each(integrate);
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark view each] "
+                  << std::chrono::duration<double, std::milli>(end - start).count() / frames
+                  << " ms/frame\n";
+    }
+
+    // --- Parallel scaling ---
+    spark::uint64 maxThreads = std::thread::hardware_concurrency();
+
+    for (spark::uint64 threads = 1; threads <= maxThreads; threads *= 2) {
+        spark::job_system jobs(threads);
+
+        auto start = clock::now();
+
+        for (int frame = 0; frame < frames; ++frame) {
+            registry.view<Position, Velocity>().par_each(jobs, integrate, 4096);
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark view par_each " << threads << " threads] "
+                  << std::chrono::duration<double, std::milli>(end - start).count() / frames
+                  << " ms/frame\n";
+
+        // finish on the full thread count when it is not a power of two
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2;
+        }
+    }
+}
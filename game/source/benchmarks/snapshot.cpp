@@ -0,0 +1,69 @@
+#include <benchmarks.hpp>
+
+#include <spark/ecs/registry.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+    struct Transform {
+        float x, y, z;
+        float yaw;
+    };
+
+    struct Health {
+        float current, maximum;
+    };
+
+    struct Sleeping {};
+}
+
+void test_spark_snapshot() {
+    using clock = std::chrono::high_resolution_clock;
+
+    constexpr int N = 1'000'000;
+
+    spark::registry registry;
+
+    for (int i = 0; i < N; ++i) {
+        auto entity = registry.create();
+
+        registry.emplace<Transform>(entity, float(i), 0.0f, 0.0f, 0.0f);
+
+        if (i % 2 == 0) {
+            registry.emplace<Health>(entity, 100.0f, 100.0f);
+        }
+
+        if (i % 5 == 0) {
+            registry.emplace<Sleeping>(entity);
+        }
+    }
+
+    spark::list<spark::uint8, spark::uint64> buffer;
+
+    // --- Snapshot ---
+    {
+        auto start = clock::now();
+
+        registry.snapshot<Transform, Health, Sleeping>(buffer);
+
+        auto end = clock::now();
+        std::cout << "[Spark snapshot " << buffer.size() / 1048576 << " MB] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    // --- Restore ---
+    {
+        spark::registry restored;
+
+        auto start = clock::now();
+
+        bool loaded = restored.restore<Transform, Health, Sleeping>({buffer.data(), buffer.size()});
+
+        auto end = clock::now();
+        std::cout << "[Spark restore" << (loaded ? "" : " FAILED") << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+}
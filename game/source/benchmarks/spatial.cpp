@@ -0,0 +1,88 @@
+#include <benchmarks.hpp>
+
+#include <spark/ecs/registry.hpp>
+#include <spark/ecs/spatial_index.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+}
+
+void test_spark_spatial_index() {
+    using clock = std::chrono::high_resolution_clock;
+
+    constexpr int N = 100'000;
+    constexpr int queries = 1'000;
+    constexpr float extent = 1000.0f;
+    constexpr float radius = 25.0f;
+
+    spark::registry registry;
+
+    for (int i = 0; i < N; ++i) {
+        auto entity = registry.create();
+
+        registry.emplace<Position>(entity, float(i % 1000), 0.0f, float(i / 1000 * 10));
+    }
+
+    spark::spatial_index<&Position::x, &Position::z> index(registry, 0.0f, 0.0f, extent, extent, 2.0f * radius);
+
+    std::size_t found = 0;
+
+    // --- Linear scan over the position pool ---
+    {
+        auto start = clock::now();
+
+        for (int q = 0; q < queries; ++q) {
+            float cx = float(q * 37 % 1000);
+            float cz = float(q * 61 % 1000);
+
+            registry.view<Position>().each([&](const Position& position) {
+                float dx = position.x - cx;
+                float dz = position.z - cz;
+
+                found += dx * dx + dz * dz <= radius * radius;
+            });
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark linear radius query x" << queries << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    // --- Grid query ---
+    {
+        auto start = clock::now();
+
+        for (int q = 0; q < queries; ++q) {
+            found += index.query(float(q * 37 % 1000), float(q * 61 % 1000), radius).size();
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark spatial_index radius query x" << queries << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    // --- Moving every entity through patch ---
+    {
+        auto start = clock::now();
+
+        for (auto entity : registry.view<Position>()) {
+            registry.patch<Position>(entity, [](Position& position) {
+                position.x += 3.0f;
+            });
+        }
+
+        auto end = clock::now();
+        std::cout << "[Spark spatial_index update " << N << " moves] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms\n";
+    }
+
+    std::cout << "[Spark spatial_index matches] " << found << "\n";
+}
@@ -0,0 +1,64 @@
+#include <benchmarks.hpp>
+
+#include <spark/types/sparse_set.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+
+    // @brief inserts count elements, reporting the total time and the slowest single insert
+    template <bool P>
+    void time_inserts(const char* label, int count) {
+        using clock = std::chrono::high_resolution_clock;
+
+        spark::sparse_set<Position, spark::uint64, false, P> set;
+
+        double worst = 0.0;
+
+        auto start = clock::now();
+
+        for (int i = 0; i < count; ++i) {
+            auto before = clock::now();
+
+            set.insert(spark::uint64(i), float(i), 0.0f, 0.0f);
+
+            auto after = clock::now();
+
+            double elapsed = std::chrono::duration<double, std::milli>(after - before).count();
+
+            worst = elapsed > worst ? elapsed : worst;
+        }
+
+        auto end = clock::now();
+
+        std::cout << "[Spark sparse_set inserts, " << label << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms, slowest insert " << worst << " ms\n";
+
+        // --- Iteration over the dense elements ---
+        start = clock::now();
+
+        float sum = 0.0f;
+
+        for (const Position& position : set) {
+            sum += position.x;
+        }
+
+        end = clock::now();
+
+        std::cout << "[Spark sparse_set iteration, " << label << "] "
+                  << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms (" << sum << ")\n";
+    }
+}
+
+void test_spark_stable_storage() {
+    constexpr int N = 10'000'000;
+
+    time_inserts<false>("contiguous", N);
+    time_inserts<true>("segmented", N);
+}
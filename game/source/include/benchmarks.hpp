@@ -0,0 +1,28 @@
+#pragma once
+
+// @brief times view::par_each over a fixed world with 1 to N worker threads
+void test_spark_parallel_view();
+
+// @brief times a registry snapshot and restore of a fixed world
+void test_spark_snapshot();
+
+// @brief times a six component update through registry views against archetype_registry chunks
+void test_spark_archetypes();
+
+// @brief times a position integration through view::each against view::each_batch
+void test_spark_batch();
+
+// @brief times radius queries through a linear view scan against spatial_index, and grid upkeep as entities move
+void test_spark_spatial_index();
+
+// @brief times list growth at 10M elements through sparse_set and dispatcher queues, with and without the byte copy path
+void test_spark_growth();
+
+// @brief times sparse_set inserts and iteration with contiguous and segmented element storage, including the slowest single insert
+void test_spark_stable_storage();
+
+// @brief times 1M-key insert, lookup and erase through spark::hash_map against std::unordered_map
+void test_spark_hash_map();
+
+// @brief times hierarchy sort and each over a 1M-entity tree, and checks parents still come first after destroying or removing a relationship
+void test_spark_hierarchy();
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <benchmarks.hpp>
 #include <entt/entt.hpp>
 #include <spark/events/dispatcher.hpp>
 
@@ -250,6 +251,33 @@ int main() {
               << std::chrono::duration<double, std::milli>(enttEnd - enttStart).count()
               << " ms\n";
 
+    std::println("testing spark::view parallel scaling");
+    test_spark_parallel_view();
+
+    std::println("testing spark::registry snapshot");
+    test_spark_snapshot();
+
+    std::println("testing spark::archetype_registry iteration");
+    test_spark_archetypes();
+
+    std::println("testing spark::view batched iteration");
+    test_spark_batch();
+
+    std::println("testing spark::spatial_index queries");
+    test_spark_spatial_index();
+
+    std::println("testing spark::list growth");
+    test_spark_growth();
+
+    std::println("testing spark::sparse_set stable storage");
+    test_spark_stable_storage();
+
+    std::println("testing spark::hash_map");
+    test_spark_hash_map();
+
+    std::println("testing spark::hierarchy ordering");
+    test_spark_hierarchy();
+
     auto totalEnd = clock::now();
     std::cout << "[Total execution time] "
               << std::chrono::duration<double, std::milli>(totalEnd - totalStart).count()
@@ -0,0 +1,564 @@
+#pragma once
+
+#include <cassert>
+#include <new>
+
+#include <spark/types/core.hpp>
+#include <spark/types/index.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/values.hpp>
+
+#include <spark/ecs/bitset.hpp>
+#include <spark/ecs/entity.hpp>
+
+namespace spark {
+    // @brief owns entities and their components, keeping entities with the same signature together in archetypes
+    // @note each archetype stores rows in fixed-size chunks holding one array per component, so wide queries walk memory linearly
+    // @note adding or removing a component moves the entity's whole row to another archetype, prefer registry for components that churn
+    // @note a separate registry rather than a storage option of registry, as archetypes group whole signatures while component_storage holds one pool per component
+    // @note entities of the two registries are not interchangeable, and views, groups, signals, hierarchy, command buffers and snapshots only work with registry
+    // @note queries go through each<Us...>(), which has no change tracking, tick filters or par_each
+    template <typename T = uint64, uint64 C = 128, uint64 I = default_index_bits<T>>
+    requires(is_unsigned<T>)
+    class archetype_registry {
+    public:
+        using size_type = T;
+        using entity_type = entity<size_type, I>;
+        using signature_type = fixed_bitset<C>;
+
+        static constexpr uint64 chunk_bytes = 16384;
+        static constexpr uint64 chunk_alignment = 64;
+
+        archetype_registry() {
+            archetypes_.emplace();
+            layout(archetypes_[0]);
+        }
+
+        ~archetype_registry() {
+            release();
+        }
+
+        archetype_registry(const archetype_registry&) = delete;
+
+        // @note the moved-from registry is left empty, holding only the archetype without components
+        archetype_registry(archetype_registry&& other) noexcept
+            : archetypes_(spark::move(other.archetypes_)), infos_(spark::move(other.infos_)), entityFreeList_(spark::move(other.entityFreeList_)),
+              entities_(spark::move(other.entities_)), locations_(spark::move(other.locations_)), typeIndexer_(spark::move(other.typeIndexer_)) {
+            other.restart();
+        }
+
+        archetype_registry& operator=(const archetype_registry&) = delete;
+
+        // @note the components of this registry are destroyed first, the moved-from registry is left empty
+        archetype_registry& operator=(archetype_registry&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+
+            release();
+
+            archetypes_ = spark::move(other.archetypes_);
+            infos_ = spark::move(other.infos_);
+            entityFreeList_ = spark::move(other.entityFreeList_);
+            entities_ = spark::move(other.entities_);
+            locations_ = spark::move(other.locations_);
+            typeIndexer_ = spark::move(other.typeIndexer_);
+
+            other.restart();
+
+            return *this;
+        }
+
+        // @note new entities start in the archetype without components
+        [[nodiscard]] entity_type create() {
+            size_type id = entities_.size();
+
+            if (!entityFreeList_.empty()) {
+                id = entityFreeList_.last();
+                entityFreeList_.pop();
+
+                entity_type& entity = entities_[id];
+
+                entity = entity_type::pack(id, entity_type::next_generation(entity.generation()));
+            }
+            else {
+                assert(id < entity_type::dead_sentinel && "registry entity capacity exceeded");
+
+                entities_.emplace() = entity_type::pack(id, 0);
+                locations_.emplace();
+            }
+
+            locations_[id] = location{0, pushRow(0, id)};
+
+            return entities_[id];
+        }
+
+        [[nodiscard]] bool contains(entity_type entity) const {
+            return entity.id() < entities_.size() && entities_[entity.id()] == entity;
+        }
+
+        // @brief destroys every component of the entity and recycles its id
+        void destroy(entity_type entity) {
+            if (!contains(entity)) {
+                return;
+            }
+
+            location here = locations_[entity.id()];
+
+            destroyRow(archetypes_[here.archetype], here.row);
+            popRow(here.archetype, here.row);
+
+            entities_[entity.id()] = entity_type::pack(entity_type::dead_sentinel, entity.generation());
+
+            entityFreeList_.emplace(entity.id());
+        }
+
+        // @brief checks if the entity owns every one of the provided components
+        template <typename... Us>
+        [[nodiscard]] bool all_of(entity_type entity) const {
+            const signature_type& current = signature(entity);
+
+            return (current.test(typeIndexer_.template find<Us>()) && ...);
+        }
+
+        // @brief checks if the entity owns at least one of the provided components
+        template <typename... Us>
+        [[nodiscard]] bool any_of(entity_type entity) const {
+            const signature_type& current = signature(entity);
+
+            return (current.test(typeIndexer_.template find<Us>()) || ...);
+        }
+
+        // @brief provides the component signature of an entity, which is also the signature of its archetype
+        [[nodiscard]] const signature_type& signature(entity_type entity) const {
+            return archetypes_[locations_[entity.id()].archetype].signature;
+        }
+
+        // @note moves the entity into the archetype that also has U
+        template <typename U, typename... Args>
+        U& emplace(entity_type entity, Args&&... args) {
+            size_type typeIndex = assure<U>();
+            size_type from = locations_[entity.id()].archetype;
+
+            if (archetypes_[from].signature.test(typeIndex)) {
+                return get<U>(entity);
+            }
+
+            size_type to = addEdge(from, typeIndex);
+            size_type row = pushRow(to, entity.id());
+
+            // @note built before the row moves, so arguments may still refer to the entity's other components
+            U* component = new (element(archetypes_[to], archetypes_[to].columns[typeIndex], row)) U(spark::forward<Args>(args)...);
+
+            migrate(entity.id(), to, row);
+
+            return *component;
+        }
+
+        // @note moves the entity into the archetype without U
+        template <typename U>
+        void remove(entity_type entity) {
+            if (!contains(entity) || !all_of<U>(entity)) {
+                return;
+            }
+
+            size_type typeIndex = typeIndexer_.template find<U>();
+            size_type to = removeEdge(locations_[entity.id()].archetype, typeIndex);
+
+            migrate(entity.id(), to, pushRow(to, entity.id()));
+        }
+
+        template <typename U>
+        [[nodiscard]] U& get(entity_type entity) {
+            location here = locations_[entity.id()];
+            archetype& table = archetypes_[here.archetype];
+
+            return *reinterpret_cast<U*>(element(table, table.columns[typeIndexer_.template find<U>()], here.row));
+        }
+
+        template <typename U>
+        [[nodiscard]] const U& get(entity_type entity) const {
+            location here = locations_[entity.id()];
+            const archetype& table = archetypes_[here.archetype];
+
+            return *reinterpret_cast<const U*>(element(table, table.columns[typeIndexer_.template find<U>()], here.row));
+        }
+
+        // @brief gives the number of entities that own every one of the provided components
+        template <typename... Us>
+        [[nodiscard]] size_type size() const {
+            size_type total = 0;
+
+            if (!masked<Us...>()) {
+                return 0;
+            }
+
+            signature_type mask = maskOf<Us...>();
+
+            for (const auto& table : archetypes_) {
+                if (table.signature.all_of(mask)) {
+                    total += table.size;
+                }
+            }
+
+            return total;
+        }
+
+        // @brief gives the number of archetypes, including the one without components
+        [[nodiscard]] size_type archetypes() const {
+            return archetypes_.size();
+        }
+
+        // @brief invokes the callable for every entity that owns all of the provided components
+        // @param callable taking (entity, Us&...) or (Us&...)
+        // @note archetypes are matched by signature, then each chunk is walked as plain arrays
+        // @note the callable must not add or remove components or entities
+        template <typename... Us, typename F>
+        requires(sizeof...(Us) > 0)
+        void each(F&& callable) {
+            if (!masked<Us...>()) {
+                return;
+            }
+
+            signature_type mask = maskOf<Us...>();
+
+            for (auto& table : archetypes_) {
+                if (table.size == 0 || !table.signature.all_of(mask)) {
+                    continue;
+                }
+
+                for (size_type chunk = 0; chunk * table.capacity < table.size; chunk++) {
+                    size_type count = min(table.capacity, static_cast<size_type>(table.size - chunk * table.capacity));
+
+                    walk(callable, reinterpret_cast<const size_type*>(table.chunks[chunk]), count, columnData<Us>(table, chunk)...);
+                }
+            }
+        }
+
+    private:
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // @brief how to move and destroy a component type without knowing it
+        struct component_info {
+            using move_function = void (*)(void*, void*);
+            using destroy_function = void (*)(void*);
+
+            uint64 size = 0;
+            uint64 alignment = 0;
+
+            move_function move = nullptr;
+            destroy_function destroy = nullptr;
+        };
+
+        // @brief where one component's array sits in every chunk of an archetype
+        struct column_layout {
+            size_type type;
+            uint64 offset;
+            uint64 size;
+        };
+
+        struct location {
+            size_type archetype = 0;
+            size_type row = 0;
+        };
+
+        // @brief every entity with a single signature, stored in chunks whose first array holds the entity ids
+        struct archetype {
+            signature_type signature;
+
+            list<column_layout, size_type> layouts;
+            list<size_type, size_type> columns;
+
+            list<uint8*, size_type> chunks;
+            size_type capacity = 0;
+            size_type size = 0;
+
+            list<size_type, size_type> addEdges;
+            list<size_type, size_type> removeEdges;
+        };
+
+        template <typename U>
+        size_type assure() {
+            static_assert(alignof(U) <= chunk_alignment, "component is over-aligned for archetype chunks");
+
+            size_type typeIndex = typeIndexer_.template index<U>();
+
+            assert(typeIndex < C && "registry component capacity exceeded");
+
+            if (typeIndex + 1 > infos_.size()) {
+                infos_.resize(typeIndex + 1);
+            }
+
+            component_info& info = infos_[typeIndex];
+
+            if (info.move == nullptr) {
+                info.size = sizeof(U);
+                info.alignment = alignof(U);
+
+                info.move = [](void* target, void* source) {
+                    new (target) U(spark::move(*static_cast<U*>(source)));
+                    static_cast<U*>(source)->~U();
+                };
+
+                info.destroy = [](void* component) {
+                    static_cast<U*>(component)->~U();
+                };
+            }
+
+            return typeIndex;
+        }
+
+        // @brief checks every provided component has been seen, as no archetype can match one that has not
+        template <typename... Us>
+        [[nodiscard]] bool masked() const {
+            return ((typeIndexer_.template find<Us>() != npos) && ...);
+        }
+
+        template <typename... Us>
+        [[nodiscard]] signature_type maskOf() const {
+            signature_type mask;
+
+            (mask.set(typeIndexer_.template find<Us>(), true), ...);
+
+            return mask;
+        }
+
+        template <typename U>
+        [[nodiscard]] U* columnData(const archetype& table, size_type chunk) const {
+            return reinterpret_cast<U*>(table.chunks[chunk] + table.layouts[table.columns[typeIndexer_.template find<U>()]].offset);
+        }
+
+        // @brief hands the callable every row of a chunk, the columns being plain arrays
+        template <typename F, typename... Us>
+        void walk(F& callable, const size_type* ids, size_type count, Us*... columns) const {
+            for (size_type row = 0; row < count; row++) {
+                if constexpr (requires { callable(entity_type(), columns[row]...); }) {
+                    callable(entities_[ids[row]], columns[row]...);
+                }
+                else {
+                    callable(columns[row]...);
+                }
+            }
+        }
+
+        // @brief destroys every component and frees every chunk, leaving the archetypes without rows
+        void release() {
+            for (auto& table : archetypes_) {
+                for (size_type row = 0; row < table.size; row++) {
+                    destroyRow(table, row);
+                }
+
+                for (uint8* chunk : table.chunks) {
+                    operator delete(chunk, std::align_val_t{chunk_alignment});
+                }
+
+                table.chunks.clear();
+                table.size = 0;
+            }
+        }
+
+        // @brief forgets every entity and component type, leaving only the archetype without components
+        // @note expects the components to be released or moved out already
+        void restart() {
+            archetypes_.clear();
+            infos_.clear();
+            entityFreeList_.clear();
+            entities_.clear();
+            locations_.clear();
+            typeIndexer_.reset();
+
+            archetypes_.emplace();
+            layout(archetypes_[0]);
+        }
+
+        // @brief assigns every column an offset, fitting as many rows into a chunk as possible
+        void layout(archetype& table) {
+            uint64 rowBytes = sizeof(size_type);
+
+            for (const auto& layoutRecord : table.layouts) {
+                rowBytes += layoutRecord.size;
+            }
+
+            size_type capacity = static_cast<size_type>(max(chunk_bytes / rowBytes, static_cast<uint64>(1)));
+
+            // @note fits also assigns the column offsets, so it must run for the final capacity outside the assert
+            bool fitted = fits(table, capacity);
+
+            while (!fitted && capacity > 1) {
+                capacity--;
+                fitted = fits(table, capacity);
+            }
+
+            assert(fitted && "archetype row does not fit in a chunk");
+
+            table.capacity = capacity;
+        }
+
+        bool fits(archetype& table, size_type capacity) {
+            uint64 offset = sizeof(size_type) * capacity;
+
+            for (auto& layoutRecord : table.layouts) {
+                uint64 alignment = infos_[layoutRecord.type].alignment;
+
+                offset = (offset + alignment - 1) / alignment * alignment;
+                layoutRecord.offset = offset;
+                offset += layoutRecord.size * capacity;
+            }
+
+            return offset <= chunk_bytes;
+        }
+
+        [[nodiscard]] static uint8* element(const archetype& table, size_type column, size_type row) {
+            const column_layout& layoutRecord = table.layouts[column];
+
+            return table.chunks[row / table.capacity] + layoutRecord.offset + (row % table.capacity) * layoutRecord.size;
+        }
+
+        [[nodiscard]] static size_type& idAt(const archetype& table, size_type row) {
+            return reinterpret_cast<size_type*>(table.chunks[row / table.capacity])[row % table.capacity];
+        }
+
+        // @brief appends an unconstructed row for the entity, allocating a chunk when the last one is full
+        size_type pushRow(size_type archetypeIndex, size_type id) {
+            archetype& table = archetypes_[archetypeIndex];
+
+            if (table.size == table.chunks.size() * table.capacity) {
+                table.chunks.emplace(static_cast<uint8*>(operator new(chunk_bytes, std::align_val_t{chunk_alignment})));
+            }
+
+            size_type row = table.size++;
+
+            idAt(table, row) = id;
+
+            return row;
+        }
+
+        // @brief drops a row whose components are already gone, moving the last row into the hole
+        // @note frees the last chunk once it empties
+        void popRow(size_type archetypeIndex, size_type row) {
+            archetype& table = archetypes_[archetypeIndex];
+
+            size_type last = table.size - 1;
+
+            if (row != last) {
+                for (size_type column = 0; column < table.layouts.size(); column++) {
+                    infos_[table.layouts[column].type].move(element(table, column, row), element(table, column, last));
+                }
+
+                size_type moved = idAt(table, last);
+
+                idAt(table, row) = moved;
+                locations_[moved].row = row;
+            }
+
+            table.size--;
+
+            if (table.size <= (table.chunks.size() - 1) * table.capacity) {
+                operator delete(table.chunks.last(), std::align_val_t{chunk_alignment});
+                table.chunks.pop();
+            }
+        }
+
+        void destroyRow(archetype& table, size_type row) {
+            for (size_type column = 0; column < table.layouts.size(); column++) {
+                infos_[table.layouts[column].type].destroy(element(table, column, row));
+            }
+        }
+
+        // @brief moves an entity's components into a row of another archetype, destroying those the target lacks
+        // @note components only the target has must already be constructed in the row
+        void migrate(size_type id, size_type to, size_type row) {
+            location here = locations_[id];
+
+            archetype& source = archetypes_[here.archetype];
+            archetype& target = archetypes_[to];
+
+            for (size_type column = 0; column < source.layouts.size(); column++) {
+                size_type type = source.layouts[column].type;
+                uint8* component = element(source, column, here.row);
+
+                if (target.signature.test(type)) {
+                    infos_[type].move(element(target, target.columns[type], row), component);
+                }
+                else {
+                    infos_[type].destroy(component);
+                }
+            }
+
+            locations_[id] = location{to, row};
+
+            popRow(here.archetype, here.row);
+        }
+
+        size_type addEdge(size_type from, size_type typeIndex) {
+            return edge(from, typeIndex, true);
+        }
+
+        size_type removeEdge(size_type from, size_type typeIndex) {
+            return edge(from, typeIndex, false);
+        }
+
+        // @brief finds the archetype reached by adding or removing one component, caching the answer
+        size_type edge(size_type from, size_type typeIndex, bool adding) {
+            auto& cached = adding ? archetypes_[from].addEdges : archetypes_[from].removeEdges;
+
+            if (typeIndex < cached.size() && cached[typeIndex] != npos) {
+                return cached[typeIndex];
+            }
+
+            signature_type target = archetypes_[from].signature;
+            target.set(typeIndex, adding);
+
+            size_type to = acquire(target);
+
+            auto& edges = adding ? archetypes_[from].addEdges : archetypes_[from].removeEdges;
+
+            if (typeIndex >= edges.size()) {
+                edges.resize(typeIndex + 1, npos);
+            }
+
+            edges[typeIndex] = to;
+
+            return to;
+        }
+
+        // @brief finds the archetype with the provided signature, creating it if needed
+        size_type acquire(const signature_type& target) {
+            for (size_type i = 0; i < archetypes_.size(); i++) {
+                if (archetypes_[i].signature == target) {
+                    return i;
+                }
+            }
+
+            archetype& table = archetypes_.emplace();
+
+            table.signature = target;
+
+            target.each([&](uint64 type) {
+                size_type typeIndex = static_cast<size_type>(type);
+
+                if (typeIndex >= table.columns.size()) {
+                    table.columns.resize(typeIndex + 1, npos);
+                }
+
+                table.columns[typeIndex] = table.layouts.size();
+                table.layouts.emplace(column_layout{typeIndex, 0, infos_[typeIndex].size});
+            });
+
+            layout(table);
+
+            return archetypes_.size() - 1;
+        }
+
+        list<archetype, size_type> archetypes_;
+        list<component_info, size_type> infos_;
+
+        list<size_type, size_type> entityFreeList_;
+        list<entity_type, size_type> entities_;
+        list<location, size_type> locations_;
+
+        type_indexer<size_type> typeIndexer_;
+    };
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstring>
+
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/soa_set.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/simd.hpp>
+
+#include <spark/ecs/component.hpp>
+#include <spark/ecs/entity.hpp>
+
+namespace spark {
+    template <typename T, uint64 I, typename... Ts>
+    requires(is_unsigned<T> && sizeof...(Ts) > 0)
+    class view;
+
+    // @brief up to W entities of a view, with every field of their column components as W-lane vectors
+    // @note when the entities sit next to each other in every column, fields are referenced in place
+    // @note otherwise fields are gathered on first access and only those taken through get are scattered back
+    // @note lanes past size() hold zeroes and are never written back, so kernels can run every lane unconditionally
+    template <typename T, uint64 I, uint64 W, typename... Ts>
+    requires(is_unsigned<T> && (is_soa_component<Ts> && ...))
+    class batch {
+    public:
+        using size_type = T;
+        using entity_type = entity<size_type, I>;
+
+        template <auto M>
+        using lane_type = unaligned_simd<member_type<M>, W>;
+
+        static constexpr uint64 width = W;
+
+        // @brief gives the number of lanes that hold an entity
+        [[nodiscard]] size_type size() const {
+            return count_;
+        }
+
+        // @brief provides the entity a lane holds
+        [[nodiscard]] entity_type entity_at(size_type index) const {
+            return (*entities_)[ids_[index]];
+        }
+
+        // @brief provides a field for every lane, to be written back once the kernel returns
+        template <auto M>
+        requires((is_same<member_owner<M>, Ts> || ...))
+        [[nodiscard]] lane_type<M>& get() {
+            if (direct_) {
+                return *reinterpret_cast<lane_type<M>*>(columnStart<M>());
+            }
+
+            auto& held = load<M>();
+
+            held.dirty = true;
+
+            return held.value;
+        }
+
+        // @brief provides a field for every lane without writing it back
+        template <auto M>
+        requires((is_same<member_owner<M>, Ts> || ...))
+        [[nodiscard]] const lane_type<M>& read() {
+            if (direct_) {
+                return *reinterpret_cast<const lane_type<M>*>(columnStart<M>());
+            }
+
+            return load<M>().value;
+        }
+
+    private:
+        template <auto M>
+        struct lane {
+            lane_type<M> value;
+            bool loaded = false;
+            bool dirty = false;
+        };
+
+        template <typename F>
+        struct component_lanes;
+
+        template <auto... Ms>
+        struct component_lanes<soa_fields<Ms...>> : lane<Ms>... {};
+
+        // @brief where the lanes of one component sit in its columns
+        template <typename U>
+        struct source {
+            component_storage<U, size_type>* pool;
+            size_type positions[W];
+            bool contiguous;
+        };
+
+        struct lane_pack : component_lanes<typename component_traits<Ts>::fields>... {};
+        struct source_pack : source<Ts>... {};
+
+        batch(const list<entity_type, size_type>& entities, component_storage<Ts, size_type>&... pools)
+            : entities_(&entities) {
+            ((static_cast<source<Ts>&>(sources_).pool = &pools), ...);
+        }
+
+        [[nodiscard]] bool full() const {
+            return count_ == W;
+        }
+
+        void push(size_type id) {
+            (locate<Ts>(id), ...);
+
+            ids_[count_++] = id;
+        }
+
+        // @brief fills the whole batch at once if every component sits at the same dense positions as the provided ids
+        // @note the ids must be W consecutive entries of one of the viewed pools, starting at position
+        bool pushRun(const size_type* ids, size_type position) {
+            if (!(aligned<Ts>(ids, position) && ...)) {
+                return false;
+            }
+
+            ((static_cast<source<Ts>&>(sources_).positions[0] = position), ...);
+            ((static_cast<source<Ts>&>(sources_).contiguous = true), ...);
+
+            std::memcpy(ids_, ids, sizeof(ids_));
+            count_ = W;
+            direct_ = true;
+
+            return true;
+        }
+
+        template <typename U>
+        bool aligned(const size_type* ids, size_type position) const {
+            auto indices = static_cast<const source<U>&>(sources_).pool->indices();
+
+            return position + W <= indices.size() && std::memcmp(indices.data() + position, ids, sizeof(ids_)) == 0;
+        }
+
+        template <typename U>
+        void locate(size_type id) {
+            auto& from = static_cast<source<U>&>(sources_);
+
+            size_type position = from.pool->position(id);
+
+            from.contiguous = count_ == 0 || (from.contiguous && position == from.positions[count_ - 1] + 1);
+            from.positions[count_] = position;
+        }
+
+        template <auto M>
+        [[nodiscard]] member_type<M>* columnStart() {
+            auto& from = static_cast<source<member_owner<M>>&>(sources_);
+
+            return from.pool->template column<M>().data() + from.positions[0];
+        }
+
+        template <auto M>
+        lane<M>& load() {
+            auto& held = static_cast<lane<M>&>(lanes_);
+
+            if (held.loaded) {
+                return held;
+            }
+
+            auto& from = static_cast<source<member_owner<M>>&>(sources_);
+            auto column = from.pool->template column<M>();
+
+            held.value = lane_type<M>{};
+
+            if (from.contiguous) {
+                std::memcpy(&held.value, &column[from.positions[0]], sizeof(member_type<M>) * count_);
+            }
+            else {
+                for (size_type i = 0; i < count_; i++) {
+                    held.value[i] = column[from.positions[i]];
+                }
+            }
+
+            held.loaded = true;
+
+            return held;
+        }
+
+        template <auto M>
+        void store() {
+            auto& held = static_cast<lane<M>&>(lanes_);
+
+            if (held.dirty) {
+                auto& from = static_cast<source<member_owner<M>>&>(sources_);
+                auto column = from.pool->template column<M>();
+
+                if (from.contiguous) {
+                    std::memcpy(&column[from.positions[0]], &held.value, sizeof(member_type<M>) * count_);
+                }
+                else {
+                    for (size_type i = 0; i < count_; i++) {
+                        column[from.positions[i]] = held.value[i];
+                    }
+                }
+            }
+
+            held.loaded = false;
+            held.dirty = false;
+        }
+
+        template <auto... Ms>
+        void storeFields(soa_fields<Ms...>) {
+            (store<Ms>(), ...);
+        }
+
+        // @brief writes back every field taken through get and empties the batch
+        void flush() {
+            if (!direct_) {
+                (storeFields(typename component_traits<Ts>::fields{}), ...);
+            }
+
+            count_ = 0;
+            direct_ = false;
+        }
+
+        const list<entity_type, size_type>* entities_;
+
+        size_type ids_[W];
+        size_type count_ = 0;
+        bool direct_ = false;
+
+        lane_pack lanes_;
+        source_pack sources_;
+
+        friend class view<size_type, I, Ts...>;
+    };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <bit>
+
 #include <spark/types/core.hpp>
 #include <spark/types/list.hpp>
 #include <spark/types/traits.hpp>
@@ -56,6 +58,17 @@ namespace spark {
             return blocks_.size() * block_size;
         }
 
+        // @brief checks if any bit is set
+        bool any() const {
+            for (uint64 i = 0; i < blocks_.size(); i++) {
+                if (blocks_[i] != 0) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
         bitset& operator|=(const bitset& other) {
             uint64 maxBlocks = max(blocks_.size(), other.blocks_.size());
             resize(maxBlocks * block_size);
@@ -151,4 +164,143 @@ namespace spark {
             }
         }
     };
+
+    // @brief bitset with a compile-time width that never allocates
+    // @note all operations touch a fixed number of blocks, so tests and masks are O(1)
+    template <uint64 N>
+    requires(N > 0)
+    class fixed_bitset {
+    public:
+        using block_type = uint64;
+
+        static constexpr uint64 block_size = sizeof(block_type) * 8;
+        static constexpr uint64 block_count = (N + block_size - 1) / block_size;
+
+        constexpr fixed_bitset() = default;
+
+        constexpr void set(uint64 index, bool value) {
+            block_type mask = block_type(1) << (index % block_size);
+
+            if (value) {
+                blocks_[index / block_size] |= mask;
+            }
+            else {
+                blocks_[index / block_size] &= ~mask;
+            }
+        }
+
+        // @note indices past the width read as unset
+        [[nodiscard]] constexpr bool test(uint64 index) const {
+            if (index >= N) {
+                return false;
+            }
+
+            return (blocks_[index / block_size] >> (index % block_size)) & 1;
+        }
+
+        // @brief clears every bit
+        constexpr void reset() {
+            for (uint64 i = 0; i < block_count; i++) {
+                blocks_[i] = 0;
+            }
+        }
+
+        // @brief checks if any bit is set
+        [[nodiscard]] constexpr bool any() const {
+            block_type combined = 0;
+
+            for (uint64 i = 0; i < block_count; i++) {
+                combined |= blocks_[i];
+            }
+
+            return combined != 0;
+        }
+
+        // @brief checks if every bit set in the mask is also set here
+        [[nodiscard]] constexpr bool all_of(const fixed_bitset& mask) const {
+            block_type missing = 0;
+
+            for (uint64 i = 0; i < block_count; i++) {
+                missing |= mask.blocks_[i] & ~blocks_[i];
+            }
+
+            return missing == 0;
+        }
+
+        // @brief checks if any bit set in the mask is also set here
+        [[nodiscard]] constexpr bool any_of(const fixed_bitset& mask) const {
+            block_type shared = 0;
+
+            for (uint64 i = 0; i < block_count; i++) {
+                shared |= mask.blocks_[i] & blocks_[i];
+            }
+
+            return shared != 0;
+        }
+
+        // @brief invokes the callable with the index of every set bit, in ascending order
+        template <typename F>
+        constexpr void each(F&& callable) const {
+            for (uint64 i = 0; i < block_count; i++) {
+                block_type block = blocks_[i];
+
+                while (block != 0) {
+                    callable(i * block_size + static_cast<uint64>(std::countr_zero(block)));
+
+                    block &= block - 1;
+                }
+            }
+        }
+
+        [[nodiscard]] static constexpr uint64 size() {
+            return N;
+        }
+
+        constexpr fixed_bitset& operator|=(const fixed_bitset& other) {
+            for (uint64 i = 0; i < block_count; i++) {
+                blocks_[i] |= other.blocks_[i];
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] constexpr fixed_bitset operator|(const fixed_bitset& other) const {
+            fixed_bitset result = *this;
+            result |= other;
+
+            return result;
+        }
+
+        constexpr fixed_bitset& operator&=(const fixed_bitset& other) {
+            for (uint64 i = 0; i < block_count; i++) {
+                blocks_[i] &= other.blocks_[i];
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] constexpr fixed_bitset operator&(const fixed_bitset& other) const {
+            fixed_bitset result = *this;
+            result &= other;
+
+            return result;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const fixed_bitset& other) const {
+            for (uint64 i = 0; i < block_count; i++) {
+                if (blocks_[i] != other.blocks_[i]) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const fixed_bitset& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        block_type blocks_[block_count] = {};
+    };
 }
\ No newline at end of file
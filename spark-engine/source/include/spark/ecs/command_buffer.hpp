@@ -0,0 +1,361 @@
+#pragma once
+
+#include <spark/types/core.hpp>
+#include <spark/types/filler.hpp>
+#include <spark/types/hash_map.hpp>
+#include <spark/types/index.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/ecs/entity.hpp>
+#include <spark/ecs/registry.hpp>
+
+#include <spark/threading/job_system.hpp>
+
+namespace spark {
+    // @brief records structural registry changes to apply later at a sync point
+    // @note playback applies creates, then the emplaces and removes of each component type, then destroys
+    // @note emplaces and removes of one component type keep their recording order, so remove then emplace leaves the new component
+    // @note emplacing a component the entity already owns replaces it, so the last recorded value wins
+    // @note destroys apply last, so commands recorded for an entity after its destruction are dropped with it
+    // @note entities returned by create() are placeholders that are only meaningful to this buffer
+    template <typename T = uint64, uint64 C = 128, uint64 I = default_index_bits<T>>
+    requires(is_unsigned<T>)
+    class command_buffer {
+    public:
+        using size_type = T;
+        using entity_type = entity<size_type, I>;
+        using registry_type = registry<size_type, C, I>;
+
+        command_buffer() = default;
+
+        ~command_buffer() {
+            reset();
+        }
+
+        command_buffer(const command_buffer&) = delete;
+
+        // @note the moved-from buffer is left empty
+        command_buffer(command_buffer&& other) noexcept
+            : families_(spark::move(other.families_)), destroyed_(spark::move(other.destroyed_)), indexer_(spark::move(other.indexer_)), placeholders_(other.placeholders_), commands_(other.commands_) {
+            other.reset();
+        }
+
+        command_buffer& operator=(const command_buffer&) = delete;
+
+        // @note unplayed emplacements of this buffer are destroyed first, the moved-from buffer is left empty
+        command_buffer& operator=(command_buffer&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+
+            reset();
+
+            families_ = spark::move(other.families_);
+            destroyed_ = spark::move(other.destroyed_);
+            indexer_ = spark::move(other.indexer_);
+            placeholders_ = other.placeholders_;
+            commands_ = other.commands_;
+
+            other.reset();
+
+            return *this;
+        }
+
+        // @brief records the creation of an entity
+        // @returns a placeholder that other commands in this buffer may refer to
+        [[nodiscard]] entity_type create() {
+            return entity_type::pack(placeholders_++, entity_type::placeholder_generation);
+        }
+
+        // @brief records the destruction of an entity
+        void destroy(entity_type entity) {
+            destroyed_.emplace(entity);
+        }
+
+        // @brief records the construction of a component
+        // @note the component is built immediately and moved into the registry on playback
+        template <typename U, typename... Args>
+        void emplace(entity_type entity, Args&&... args) {
+            auto& emplacements = acquireEmplacements<U>();
+
+            emplacements.emplace(entity, commands_, U(spark::forward<Args>(args)...));
+        }
+
+        // @brief records the removal of a component
+        template <typename U>
+        void remove(entity_type entity) {
+            auto& record = acquireFamily<U>();
+
+            record.removals.emplace(entity, commands_);
+        }
+
+        // @brief checks if no commands have been recorded
+        [[nodiscard]] bool empty() const {
+            return commands_ == 0 && placeholders_ == 0 && destroyed_.empty();
+        }
+
+        // @brief applies every recorded command to the registry, then clears the buffer
+        void playback(registry_type& owner) {
+            list<entity_type, size_type> created;
+            created.reserve(placeholders_);
+
+            for (size_type i = 0; i < placeholders_; i++) {
+                created.emplace(owner.create());
+            }
+
+            for (auto& family : families_) {
+                if (family.playCommands != nullptr) {
+                    family.reserveEmplacements(owner, family.countEmplacements(&family.emplacementFiller));
+                    family.playCommands(&family.emplacementFiller, family.removals, owner, created);
+                }
+            }
+
+            for (auto& entity : destroyed_) {
+                owner.destroy(resolve(entity, created));
+            }
+
+            clear();
+        }
+
+        // @brief discards every recorded command
+        void clear() {
+            for (auto& family : families_) {
+                if (family.clearEmplacements != nullptr) {
+                    family.clearEmplacements(&family.emplacementFiller);
+                }
+
+                family.removals.clear();
+            }
+
+            destroyed_.clear();
+
+            placeholders_ = 0;
+            commands_ = 0;
+        }
+
+        // @brief discards every recorded command and forgets every component type
+        void reset() {
+            for (auto& family : families_) {
+                if (family.destructEmplacements != nullptr) {
+                    family.destructEmplacements(&family.emplacementFiller);
+                }
+            }
+
+            families_.clear();
+            indexer_.reset();
+            destroyed_.clear();
+
+            placeholders_ = 0;
+            commands_ = 0;
+        }
+
+    private:
+        template <typename U, uint64 N, uint64 J>
+        requires(is_unsigned<U>)
+        friend class command_buffers;
+
+        // @note sequence is the position of the command in the buffer, used to interleave emplaces and removes
+        template <typename U>
+        struct emplacement {
+            entity_type entity;
+            size_type sequence;
+            U value;
+        };
+
+        struct removal {
+            entity_type entity;
+            size_type sequence;
+        };
+
+        // @brief the recorded commands for a single component type
+        struct command_family {
+            using list_dummy = list<size_type, size_type>;
+            using list_filler = filler_of<list_dummy>;
+            using list_function = void (*)(void*);
+            using list_count = size_type (*)(const void*);
+
+            using pool_reservation = void (*)(registry_type&, size_type);
+            using family_playback = void (*)(void*, list<removal, size_type>&, registry_type&, const list<entity_type, size_type>&);
+
+            uint64 type = 0;
+
+            list_filler emplacementFiller;
+            list_function clearEmplacements = nullptr;
+            list_function destructEmplacements = nullptr;
+            list_count countEmplacements = nullptr;
+
+            list<removal, size_type> removals;
+
+            pool_reservation reserveEmplacements = nullptr;
+            family_playback playCommands = nullptr;
+        };
+
+        [[nodiscard]] static entity_type resolve(entity_type entity, const list<entity_type, size_type>& created) {
+            bool placeholder = entity.generation() == entity_type::placeholder_generation && entity.id() != entity_type::dead_sentinel;
+
+            return placeholder ? created[entity.id()] : entity;
+        }
+
+        template <typename U>
+        command_family& acquireFamily() {
+            using emplacement_list = list<emplacement<U>, size_type>;
+
+            size_type index = indexer_.template index<U>();
+
+            if (index + 1 > families_.size()) {
+                families_.resize(index + 1);
+            }
+
+            auto& record = families_[index];
+
+            commands_++;
+
+            if (record.destructEmplacements != nullptr) {
+                return record;
+            }
+
+            new (static_cast<void*>(&record.emplacementFiller)) emplacement_list();
+
+            record.type = type_hash<U>();
+
+            record.destructEmplacements = [](void* filler) {
+                reinterpret_cast<emplacement_list*>(filler)->~emplacement_list();
+            };
+
+            record.clearEmplacements = [](void* filler) {
+                reinterpret_cast<emplacement_list*>(filler)->clear();
+            };
+
+            record.countEmplacements = [](const void* filler) {
+                return reinterpret_cast<const emplacement_list*>(filler)->size();
+            };
+
+            // @note grows the pool at most once for a batch, and geometrically, so steady frames stop reallocating
+            record.reserveEmplacements = [](registry_type& owner, size_type count) {
+                if (count == 0) {
+                    return;
+                }
+
+                size_type needed = owner.template size<U>() + count;
+                size_type capacity = owner.template capacity<U>();
+
+                if (needed > capacity) {
+                    owner.template reserve<U>(max(needed, capacity * 2));
+                }
+            };
+
+            // @note both lists are in recording order, so merging them by sequence replays the commands as recorded
+            record.playCommands = [](void* filler, list<removal, size_type>& removals, registry_type& owner, const list<entity_type, size_type>& created) {
+                auto& commands = *reinterpret_cast<emplacement_list*>(filler);
+
+                size_type next = 0;
+
+                for (auto& command : commands) {
+                    for (; next < removals.size() && removals[next].sequence < command.sequence; next++) {
+                        owner.template remove<U>(resolve(removals[next].entity, created));
+                    }
+
+                    entity_type entity = resolve(command.entity, created);
+
+                    if (owner.template all_of<U>(entity)) {
+                        owner.template patch<U>(entity, [&](U& component) {
+                            component = spark::move(command.value);
+                        });
+                    }
+                    else {
+                        owner.template emplace<U>(entity, spark::move(command.value));
+                    }
+                }
+
+                for (; next < removals.size(); next++) {
+                    owner.template remove<U>(resolve(removals[next].entity, created));
+                }
+            };
+
+            return record;
+        }
+
+        template <typename U>
+        list<emplacement<U>, size_type>& acquireEmplacements() {
+            auto& record = acquireFamily<U>();
+
+            return *reinterpret_cast<list<emplacement<U>, size_type>*>(&record.emplacementFiller);
+        }
+
+        list<command_family, size_type> families_;
+        list<entity_type, size_type> destroyed_;
+
+        type_indexer<size_type> indexer_;
+
+        size_type placeholders_ = 0;
+        size_type commands_ = 0;
+    };
+
+    // @brief one command buffer per job system thread, so workers record without synchronising
+    // @note placeholders from one thread's buffer must not be used in another's
+    template <typename T = uint64, uint64 C = 128, uint64 I = default_index_bits<T>>
+    requires(is_unsigned<T>)
+    class command_buffers {
+    public:
+        using size_type = T;
+        using buffer_type = command_buffer<size_type, C, I>;
+        using registry_type = buffer_type::registry_type;
+
+        explicit command_buffers(const job_system& jobs)
+            : jobs_(&jobs) {
+            buffers_.resize(jobs.size());
+        }
+
+        // @brief provides the calling thread's buffer
+        [[nodiscard]] buffer_type& local() {
+            return buffers_[jobs_->worker()];
+        }
+
+        // @brief applies every thread's commands in thread order, then clears them
+        // @note each pool is grown once for the emplacements of every thread together, before any buffer plays
+        void playback(registry_type& owner) {
+            for (auto& buffer : buffers_) {
+                for (auto& family : buffer.families_) {
+                    if (family.playCommands == nullptr) {
+                        continue;
+                    }
+
+                    auto& pending = reservations_[family.type];
+
+                    pending.count += family.countEmplacements(&family.emplacementFiller);
+                    pending.reserve = family.reserveEmplacements;
+                }
+            }
+
+            reservations_.each([&](uint64, reservation& pending) {
+                pending.reserve(owner, pending.count);
+            });
+
+            reservations_.clear();
+
+            for (auto& buffer : buffers_) {
+                buffer.playback(owner);
+            }
+        }
+
+        // @brief discards every thread's commands
+        void clear() {
+            for (auto& buffer : buffers_) {
+                buffer.clear();
+            }
+        }
+
+    private:
+        // @brief the emplacements of one component type summed over every thread
+        struct reservation {
+            size_type count = 0;
+            buffer_type::command_family::pool_reservation reserve = nullptr;
+        };
+
+        const job_system* jobs_;
+        list<buffer_type, uint64> buffers_;
+
+        hash_map<uint64, reservation, hasher<uint64>, size_type> reservations_;
+    };
+}
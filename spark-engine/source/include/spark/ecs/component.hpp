@@ -0,0 +1,47 @@
+#pragma once
+
+#include <spark/types/core.hpp>
+#include <spark/types/soa_set.hpp>
+#include <spark/types/sparse_set.hpp>
+#include <spark/types/traits.hpp>
+
+namespace spark {
+    // @brief per-component options, specialise it to opt a component into extra bookkeeping
+    // @note a specialisation may also declare `using fields = soa_fields<&T::a, &T::b, ...>` to store the component as columns
+    // @note or `static constexpr bool stable_addresses = true` to keep components at the same address for their whole lifetime
+    template <typename T>
+    struct component_traits {
+        // @brief keeps the tick each component was added and last changed at
+        // @note changes are recorded by registry::emplace, registry::patch and mutable registry::get, not by views or groups
+        static constexpr bool track_changes = false;
+    };
+
+    // @brief true for components stored as one column per field, see soa_set
+    // @note such components are read as copies, changed through registry::patch or their columns, and cannot be sorted or snapshotted
+    template <typename T>
+    inline constexpr bool is_soa_component = requires { typename component_traits<T>::fields; };
+
+    // @brief true for components stored in fixed-size blocks, see segmented_list
+    // @note references to such components survive other components being added, the pool growing never copies them
+    template <typename T>
+    inline constexpr bool is_stable_component = requires { requires component_traits<T>::stable_addresses; };
+
+    namespace detail {
+        template <typename T, typename U, bool S>
+        struct storage_selector {
+            using type = sparse_set<T, U, component_traits<T>::track_changes, is_stable_component<T>>;
+        };
+
+        template <typename T, typename U>
+        struct storage_selector<T, U, true> {
+            static_assert(!component_traits<T>::track_changes, "column components cannot track changes");
+            static_assert(!is_stable_component<T>, "column components cannot have stable addresses");
+
+            using type = soa_set<T, typename component_traits<T>::fields, U>;
+        };
+    }
+
+    // @brief the set a registry stores a component in
+    template <typename T, typename U = uint64>
+    using component_storage = detail::storage_selector<T, U, is_soa_component<T>>::type;
+}
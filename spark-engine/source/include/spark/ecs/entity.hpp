@@ -4,15 +4,33 @@
 #include <spark/types/traits.hpp>
 
 namespace spark {
-    template <typename T = uint64>
-    requires(is_unsigned<T>)
+    // @brief default number of index bits of an entity, leaving 60% of T for the index and the rest for the version
+    template <typename T>
+    inline constexpr uint64 default_index_bits = sizeof(T) * 5;
+
+    // @brief handle packing an index and a version into a single integer
+    // @note I bits hold the index and the rest hold the version, 20/12 for uint32 and 40/24 for uint64 by default
+    // @note the all-ones index marks a null or destroyed handle, the all-ones version is reserved for placeholders
+    template <typename T = uint64, uint64 I = default_index_bits<T>>
+    requires(is_unsigned<T> && I > 0 && I < sizeof(T) * 8)
     class entity {
     public:
         using size_type = T;
 
+        static constexpr uint64 index_bits = I;
+        static constexpr uint64 version_bits = sizeof(T) * 8 - I;
+
+        static constexpr size_type index_mask = static_cast<size_type>((static_cast<size_type>(1) << index_bits) - 1);
+        static constexpr size_type version_mask = static_cast<size_type>((static_cast<size_type>(1) << version_bits) - 1);
+
         entity() = default;
         ~entity() = default;
 
+        // @brief rebuilds a handle from its packed value, e.g. one received over the network
+        explicit constexpr entity(size_type value)
+            : value_(value) {
+        }
+
         entity(const entity&) = default;
         entity(entity&&) noexcept = default;
 
@@ -20,7 +38,7 @@ namespace spark {
         entity& operator=(entity&&) noexcept = default;
 
         bool operator==(const entity& other) const {
-            return id_ = other.id_ && generation_ == other.generation_;
+            return value_ == other.value_;
         }
 
         bool operator!=(const entity& other) const {
@@ -28,21 +46,43 @@ namespace spark {
         }
 
         [[nodiscard]] size_type id() const {
-            return id_;
+            return static_cast<size_type>(value_ & index_mask);
         }
 
         [[nodiscard]] size_type generation() const {
-            return generation_;
+            return static_cast<size_type>(value_ >> index_bits);
+        }
+
+        // @brief gives the packed index and version
+        [[nodiscard]] size_type value() const {
+            return value_;
         }
 
     private:
-        static constexpr size_type dead_sentinel = static_cast<size_type>(-1);
+        static constexpr size_type dead_sentinel = index_mask;
+        static constexpr size_type placeholder_generation = version_mask;
 
-        size_type id_ = dead_sentinel;
-        size_type generation_ = dead_sentinel;
+        static constexpr entity pack(size_type id, size_type generation) {
+            return entity(static_cast<size_type>((id & index_mask) | static_cast<size_type>(generation << index_bits)));
+        }
 
-        template <typename U>
+        // @brief gives the version after the provided one, wrapping before the reserved placeholder version
+        static constexpr size_type next_generation(size_type generation) {
+            return generation + 1 >= placeholder_generation ? 0 : static_cast<size_type>(generation + 1);
+        }
+
+        size_type value_ = static_cast<size_type>(-1);
+
+        template <typename U, uint64 C, uint64 J>
         requires(is_unsigned<U>)
         friend class registry;
+
+        template <typename U, uint64 C, uint64 J>
+        requires(is_unsigned<U>)
+        friend class command_buffer;
+
+        template <typename U, uint64 C, uint64 J>
+        requires(is_unsigned<U>)
+        friend class archetype_registry;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/span.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/ecs/component.hpp>
+#include <spark/ecs/entity.hpp>
+
+namespace spark {
+    // @brief list of components a group owns
+    template <typename... Ts>
+    struct owned_t {
+        explicit constexpr owned_t() = default;
+    };
+
+    // @brief list of components a group observes without owning
+    template <typename... Ts>
+    struct get_t {
+        explicit constexpr get_t() = default;
+    };
+
+    // @brief list of components that exclude an entity from a group
+    template <typename... Ts>
+    struct exclude_t {
+        explicit constexpr exclude_t() = default;
+    };
+
+    template <typename... Ts>
+    inline constexpr get_t<Ts...> get{};
+
+    template <typename... Ts>
+    inline constexpr exclude_t<Ts...> exclude{};
+
+    template <typename T, uint64 I, typename, typename, typename>
+    class group;
+
+    // @brief iterates entities whose owned components are packed at the front of their pools
+    // @note the first size() elements of every owned pool line up, so owned components are walked linearly
+    // @note invalidated by any structural change to the registry it was taken from
+    template <typename T, uint64 I, typename... Os, typename... Gs, typename... Es>
+    requires(is_unsigned<T> && sizeof...(Os) > 0)
+    class group<T, I, owned_t<Os...>, get_t<Gs...>, exclude_t<Es...>> {
+    public:
+        using size_type = T;
+        using entity_type = entity<size_type, I>;
+
+        class iterator {
+        public:
+            iterator(const group* owner, size_type position)
+                : owner_(owner), position_(position) {
+            }
+
+            [[nodiscard]] entity_type operator*() const {
+                return (*owner_->entities_)[owner_->indices()[position_]];
+            }
+
+            iterator& operator++() {
+                position_++;
+
+                return *this;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& other) const {
+                return position_ == other.position_;
+            }
+
+            [[nodiscard]] bool operator!=(const iterator& other) const {
+                return position_ != other.position_;
+            }
+
+        private:
+            const group* owner_;
+            size_type position_;
+        };
+
+        group(const list<entity_type, size_type>& entities, size_type length, component_storage<Os, size_type>&... owned, component_storage<Gs, size_type>&... observed)
+            : entities_(&entities), length_(length), pools_(&owned..., &observed...) {
+        }
+
+        // @brief checks if the entity is a member of the group
+        [[nodiscard]] bool contains(entity_type entity) const {
+            auto& lead = pools_.template get<lead_type>();
+
+            return lead.contains(entity.id()) && lead.position(entity.id()) < length_;
+        }
+
+        // @brief provides a grouped component of an entity
+        // @note the entity must be contained in the group
+        // @note column components are returned as a copy
+        template <typename U>
+        [[nodiscard]] decltype(auto) get(entity_type entity) const {
+            return pools_.template get<U>().get(entity.id());
+        }
+
+        // @brief provides one field of an owned column component for every entity in the group
+        // @note owned pools line up, so columns of different owned components can be walked with a single index
+        template <auto M>
+        requires(is_soa_component<member_owner<M>> && (is_same<member_owner<M>, Os> || ...))
+        [[nodiscard]] span<member_type<M>, size_type> column() const {
+            return pools_.template get<member_owner<M>>().template column<M>().subspan(0, length_);
+        }
+
+        // @brief gives the number of entities in the group
+        [[nodiscard]] size_type size() const {
+            return length_;
+        }
+
+        // @brief checks if the group has no entities
+        [[nodiscard]] bool empty() const {
+            return length_ == 0;
+        }
+
+        // @brief invokes the callable for every entity in the group
+        // @param callable taking (entity, Os&..., Gs&...) or (Os&..., Gs&...)
+        template <typename F>
+        void each(F&& callable) const {
+            const size_type* ids = indices();
+
+            for (size_type i = 0; i < length_; i++) {
+                size_type id = ids[i];
+
+                if constexpr (requires { callable(entity_type(), pools_.template get<Os>().at(i)..., pools_.template get<Gs>().get(id)...); }) {
+                    callable((*entities_)[id], pools_.template get<Os>().at(i)..., pools_.template get<Gs>().get(id)...);
+                }
+                else {
+                    callable(pools_.template get<Os>().at(i)..., pools_.template get<Gs>().get(id)...);
+                }
+            }
+        }
+
+        [[nodiscard]] iterator begin() const {
+            return iterator(this, 0);
+        }
+
+        [[nodiscard]] iterator end() const {
+            return iterator(this, length_);
+        }
+
+    private:
+        using lead_type = first_of<Os...>;
+
+        template <typename U>
+        struct holder {
+            component_storage<U, size_type>* pool;
+        };
+
+        struct pool_pack : holder<Os>..., holder<Gs>... {
+            explicit pool_pack(component_storage<Os, size_type>*... owned, component_storage<Gs, size_type>*... observed)
+                : holder<Os>{owned}..., holder<Gs>{observed}... {
+            }
+
+            template <typename U>
+            component_storage<U, size_type>& get() const {
+                return *static_cast<const holder<U>&>(*this).pool;
+            }
+        };
+
+        [[nodiscard]] const size_type* indices() const {
+            return pools_.template get<lead_type>().indices().data();
+        }
+
+        const list<entity_type, size_type>* entities_;
+        size_type length_;
+        pool_pack pools_;
+    };
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+
+#include <spark/types/core.hpp>
+#include <spark/types/small_list.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/sorting.hpp>
+
+#include <spark/ecs/entity.hpp>
+#include <spark/ecs/registry.hpp>
+
+namespace spark {
+    // @brief links of an entity within a hierarchy, stored as a regular component
+    // @note a default entity marks a missing link, roots have no parent and a depth of 0
+    template <typename T = uint64, uint64 I = default_index_bits<T>>
+    requires(is_unsigned<T>)
+    struct relationship {
+        using size_type = T;
+        using entity_type = entity<size_type, I>;
+
+        entity_type parent;
+        entity_type firstChild;
+        entity_type nextSibling;
+        entity_type previousSibling;
+
+        size_type children = 0;
+        size_type depth = 0;
+    };
+
+    // @brief maintains parent, child and sibling links between entities of a registry
+    // @note the relationship pool is kept ordered by depth, so walking it visits every parent before its children
+    // @note destroying an entity or removing its relationship unlinks it and turns its children into roots, and reorders the pool on the next walk
+    // @note a registry can hold a single hierarchy, as it owns the order of the relationship pool
+    template <typename T = uint64, uint64 C = 128, uint64 I = default_index_bits<T>>
+    requires(is_unsigned<T>)
+    class hierarchy {
+    public:
+        using size_type = T;
+        using entity_type = entity<size_type, I>;
+        using registry_type = registry<size_type, C, I>;
+        using relationship_type = relationship<size_type, I>;
+
+        explicit hierarchy(registry_type& owner)
+            : registry_(&owner) {
+            registry_->template on_destroy<relationship_type>().template connect<&hierarchy::onDestroy>(*this);
+        }
+
+        ~hierarchy() {
+            registry_->template on_destroy<relationship_type>().template disconnect<&hierarchy::onDestroy>(*this);
+        }
+
+        hierarchy(const hierarchy&) = delete;
+        hierarchy(hierarchy&&) = delete;
+
+        hierarchy& operator=(const hierarchy&) = delete;
+        hierarchy& operator=(hierarchy&&) = delete;
+
+        // @brief makes an entity the first child of another, moving its whole subtree along
+        // @note the parent must not be the child or one of its descendants
+        void attach(entity_type child, entity_type parent) {
+            assert(registry_->contains(child) && registry_->contains(parent) && "cannot attach a destroyed entity");
+            assert(child != parent && !descends(parent, child) && "cannot attach an entity below itself");
+
+            assure(parent);
+            assure(child);
+
+            unlink(child);
+
+            relationship_type& parentLink = link(parent);
+            relationship_type& childLink = link(child);
+
+            childLink.parent = parent;
+            childLink.nextSibling = parentLink.firstChild;
+
+            if (parentLink.firstChild != entity_type()) {
+                link(parentLink.firstChild).previousSibling = child;
+            }
+
+            parentLink.firstChild = child;
+            parentLink.children++;
+
+            deepen(child, parentLink.depth + 1);
+        }
+
+        // @brief turns an entity into a root, keeping its own subtree
+        void detach(entity_type child) {
+            if (!contains(child)) {
+                return;
+            }
+
+            unlink(child);
+            deepen(child, 0);
+        }
+
+        // @brief checks if the entity is part of the hierarchy
+        [[nodiscard]] bool contains(entity_type entity) const {
+            return registry_->contains(entity) && registry_->template all_of<relationship_type>(entity);
+        }
+
+        // @brief provides the links of an entity
+        // @note the entity must be part of the hierarchy
+        [[nodiscard]] const relationship_type& get(entity_type entity) const {
+            return static_cast<const registry_type&>(*registry_).template get<relationship_type>(entity);
+        }
+
+        // @brief checks if an entity sits anywhere below another
+        [[nodiscard]] bool descends(entity_type entity, entity_type ancestor) const {
+            if (!contains(entity)) {
+                return false;
+            }
+
+            for (entity_type current = get(entity).parent; current != entity_type(); current = get(current).parent) {
+                if (current == ancestor) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // @brief restores depth order after links changed
+        // @note insertion sort when only a few entities moved, as it pays for how far they moved, merge sort for bulk changes
+        void sort() {
+            if (!dirty_) {
+                return;
+            }
+
+            size_type size = registry_->template size<relationship_type>();
+
+            if (moved_ <= static_cast<size_type>(std::bit_width(size))) {
+                registry_->template sort<relationship_type, insertion_sort, by_depth>();
+            }
+            else {
+                registry_->template sort<relationship_type, merge_sort, by_depth>();
+            }
+
+            dirty_ = false;
+            moved_ = 0;
+        }
+
+        // @brief invokes the callable for every entity in the hierarchy, parents before their children
+        // @param callable taking (entity, parent), the parent being a default entity for roots
+        // @note sort other components with registry::sort_as<U, relationship> to walk them linearly as well
+        template <typename F>
+        void each(F&& callable) {
+            sort();
+
+            registry_->template view<relationship_type>().each([&callable](entity_type entity, const relationship_type& links) {
+                callable(entity, links.parent);
+            });
+        }
+
+    private:
+        struct by_depth {
+            static bool compare(const relationship_type& a, const relationship_type& b) {
+                return a.depth < b.depth;
+            }
+        };
+
+        [[nodiscard]] relationship_type& link(entity_type entity) {
+            return registry_->template get<relationship_type>(entity);
+        }
+
+        void assure(entity_type entity) {
+            if (!registry_->template all_of<relationship_type>(entity)) {
+                registry_->template emplace<relationship_type>(entity);
+
+                dirty_ = true;
+                moved_++;
+            }
+        }
+
+        // @brief removes an entity from its parent and siblings, leaving its own children in place
+        void unlink(entity_type entity) {
+            relationship_type& links = link(entity);
+
+            if (links.parent == entity_type()) {
+                return;
+            }
+
+            relationship_type& parentLink = link(links.parent);
+
+            if (links.previousSibling != entity_type()) {
+                link(links.previousSibling).nextSibling = links.nextSibling;
+            }
+            else {
+                parentLink.firstChild = links.nextSibling;
+            }
+
+            if (links.nextSibling != entity_type()) {
+                link(links.nextSibling).previousSibling = links.previousSibling;
+            }
+
+            parentLink.children--;
+
+            links.parent = entity_type();
+            links.nextSibling = entity_type();
+            links.previousSibling = entity_type();
+        }
+
+        // @brief sets the depth of a subtree, marking the pool for sorting if anything moved
+        void deepen(entity_type root, size_type depth) {
+            if (link(root).depth == depth) {
+                return;
+            }
+
+            small_list<entity_type, 16, size_type> pending;
+            pending.emplace(root);
+
+            link(root).depth = depth;
+            moved_++;
+
+            while (!pending.empty()) {
+                entity_type current = pending.last();
+                pending.pop();
+
+                size_type childDepth = link(current).depth + 1;
+
+                for (entity_type child = link(current).firstChild; child != entity_type(); child = link(child).nextSibling) {
+                    link(child).depth = childDepth;
+                    pending.emplace(child);
+                    moved_++;
+                }
+            }
+
+            dirty_ = true;
+        }
+
+        void onDestroy(const entity_type& entity) {
+            unlink(entity);
+
+            entity_type child = link(entity).firstChild;
+
+            while (child != entity_type()) {
+                relationship_type& childLink = link(child);
+                entity_type next = childLink.nextSibling;
+
+                childLink.parent = entity_type();
+                childLink.nextSibling = entity_type();
+                childLink.previousSibling = entity_type();
+
+                deepen(child, 0);
+
+                child = next;
+            }
+
+            link(entity).firstChild = entity_type();
+            link(entity).children = 0;
+
+            // @note the pool removes by swapping the last element in, which can land a child ahead of its parent
+            dirty_ = true;
+            moved_++;
+        }
+
+        registry_type* registry_;
+
+        bool dirty_ = false;
+
+        // @brief entities whose position in depth order may have changed since the last sort
+        size_type moved_ = 0;
+    };
+}
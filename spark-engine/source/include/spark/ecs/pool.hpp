@@ -0,0 +1,48 @@
+#pragma once
+
+#include <spark/types/filler.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/sparse_set.hpp>
+
+#include <spark/events/signal.hpp>
+
+#include <spark/ecs/entity.hpp>
+
+namespace spark {
+    // @brief type-erased bookkeeping for a single component type within a registry
+    template <typename T = uint64, uint64 I = default_index_bits<T>>
+    requires(is_unsigned<T>)
+    struct pool {
+        using size_type = T;
+        using signal_type = signal<entity<size_type, I>, size_type>;
+
+        // @note the ticked, stable layout is the largest a component storage takes
+        using sparse_set_dummy = sparse_set<size_type, size_type, true, true>;
+        using sparse_set_filler = filler_of<sparse_set_dummy>;
+        using sparse_set_destructor = void (*)(void*);
+        using component_remover = void (*)(void*, size_type);
+
+        // @brief notifies a group that an entity gained or is about to lose this component
+        struct hook {
+            using call_function = void (*)(void*, size_type, size_type);
+
+            size_type group;
+            call_function call;
+        };
+
+        static constexpr size_type no_owner = static_cast<size_type>(-1);
+
+        sparse_set_filler sparseSetFiller;
+        sparse_set_destructor destructSparseSet = nullptr;
+        component_remover removeComponent = nullptr;
+
+        list<hook, size_type> constructHooks;
+        list<hook, size_type> destroyHooks;
+
+        signal_type onConstruct;
+        signal_type onUpdate;
+        signal_type onDestroy;
+
+        size_type owner = no_owner;
+    };
+}
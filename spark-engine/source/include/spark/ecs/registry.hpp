@@ -1,25 +1,40 @@
 #pragma once
 
+#include <cassert>
+#include <new>
+
 #include <spark/types/filler.hpp>
 #include <spark/types/index.hpp>
 #include <spark/types/sparse_set.hpp>
 
+#include <spark/events/sink.hpp>
+
 #include <spark/ecs/bitset.hpp>
+#include <spark/ecs/component.hpp>
 #include <spark/ecs/entity.hpp>
+#include <spark/ecs/group.hpp>
+#include <spark/ecs/pool.hpp>
+#include <spark/ecs/snapshot.hpp>
+#include <spark/ecs/view.hpp>
 
 namespace spark {
-    template <typename T = uint64>
+    // @brief owns entities and their components
+    // @note C bounds the number of distinct component types, as every entity keeps a C-bit signature
+    // @note I is the number of entity index bits, trading the entity capacity against the versions before an id repeats
+    template <typename T = uint64, uint64 C = 128, uint64 I = default_index_bits<T>>
     requires(is_unsigned<T>)
     class registry {
     public:
         using size_type = T;
-        using entity_type = entity<size_type>;
+        using entity_type = entity<size_type, I>;
+        using signature_type = fixed_bitset<C>;
+        using sink_type = sink<entity_type, size_type>;
 
         registry() = default;
         ~registry() {
-            for (size_type i = 0; i < sparseSets_.size(); i++) {
-                if (sparseSetDestructors_[i]) {
-                    sparseSetDestructors_[i](&sparseSets_[i]);
+            for (auto& record : pools_) {
+                if (record.destructSparseSet != nullptr) {
+                    record.destructSparseSet(&record.sparseSetFiller);
                 }
             }
         }
@@ -30,6 +45,7 @@ namespace spark {
         registry& operator=(const registry&) = delete;
         registry& operator=(registry&&) noexcept = default;
 
+        // @note recycled ids get the next version, which wraps around once every version has been handed out
         [[nodiscard]] entity_type create() {
             size_type id = entities_.size();
 
@@ -39,115 +55,1016 @@ namespace spark {
 
                 entity_type& entity = entities_[id];
 
-                entity.id_ = id;
-                entity.generation_++;
+                entity = entity_type::pack(id, entity_type::next_generation(entity.generation()));
 
                 return entity;
             }
             else {
+                assert(id < entity_type::dead_sentinel && "registry entity capacity exceeded");
+
                 entity_type& entity = entities_.emplace();
+                signatures_.emplace();
 
-                entity.id_ = id;
-                entity.generation_ = 0;
+                entity = entity_type::pack(id, 0);
 
                 return entity;
             }
         }
 
         [[nodiscard]] bool contains(entity_type entity) const {
-            return entities_.size() > entity.id_ && entities_[entity.id_].generation_ == entity.generation_;
+            return entity.id() < entities_.size() && entities_[entity.id()] == entity;
         }
 
+        // @brief removes every component of the entity and recycles its id
+        // @note only the pools named in the entity's signature are visited
         void destroy(entity_type entity) {
             if (!contains(entity)) {
                 return;
             }
 
-            entities_[entity.id_].id_ = entity_type::dead_sentinel;
+            signatures_[entity.id()].each([&](uint64 typeIndex) {
+                pools_[static_cast<size_type>(typeIndex)].removeComponent(this, entity.id());
+            });
 
-            entityFreeList_.emplace(entity.id_);
+            entities_[entity.id()] = entity_type::pack(entity_type::dead_sentinel, entity.generation());
 
-            // TODO: remove entity from all sparse sets
-            // will be done once component tracking is introduced
+            entityFreeList_.emplace(entity.id());
         }
 
+        // @brief checks if the entity owns every one of the provided components
+        template <typename... Us>
+        [[nodiscard]] bool all_of(entity_type entity) const {
+            const signature_type& signature = signatures_[entity.id()];
+
+            return (signature.test(typeIndexer_.template find<Us>()) && ...);
+        }
+
+        // @brief checks if the entity owns at least one of the provided components
+        template <typename... Us>
+        [[nodiscard]] bool any_of(entity_type entity) const {
+            const signature_type& signature = signatures_[entity.id()];
+
+            return (signature.test(typeIndexer_.template find<Us>()) || ...);
+        }
+
+        // @brief provides the component signature of an entity, one bit per component type
+        [[nodiscard]] const signature_type& signature(entity_type entity) const {
+            return signatures_[entity.id()];
+        }
+
+        // @note column components are returned as a copy
         template <typename U, typename... Args>
-        U& emplace(entity_type entity, Args&&... args) {
-            using sparse_set_type = sparse_set<U, size_type>;
+        decltype(auto) emplace(entity_type entity, Args&&... args) {
+            auto& sparseSet = assure<U>();
+
+            if (!sparseSet.contains(entity.id())) {
+                size_type typeIndex = typeIndexer_.template index<U>();
+
+                sparseSet.insert(entity.id(), spark::forward<Args>(args)...);
+
+                if constexpr (component_traits<U>::track_changes) {
+                    sparseSet.stamp(entity.id(), tick_);
+                }
+                signatures_[entity.id()].set(typeIndex, true);
+
+                for (auto& hook : pools_[typeIndex].constructHooks) {
+                    hook.call(this, hook.group, entity.id());
+                }
+
+                notify(pools_[typeIndex].onConstruct, entity);
+            }
+
+            return pool<U>().get(entity.id());
+        }
+
+        // @brief applies every callable to a component in place, then notifies its update listeners
+        // @param callables taking (U&)
+        // @note column components are gathered into a copy, patched, and scattered back
+        template <typename U, typename... Fs>
+        decltype(auto) patch(entity_type entity, Fs&&... callables) {
+            if constexpr (is_soa_component<U>) {
+                U component = pool<U>().get(entity.id());
+
+                (callables(component), ...);
+
+                pool<U>().set(entity.id(), component);
+            }
+            else {
+                U& component = pool<U>().get(entity.id());
+
+                (callables(component), ...);
+            }
+
+            if constexpr (component_traits<U>::track_changes) {
+                pool<U>().touch(entity.id(), tick_);
+            }
+
+            notify(pools_[typeIndexer_.template index<U>()].onUpdate, entity);
+
+            return pool<U>().get(entity.id());
+        }
+
+        // @note counts as a change of components that track changes
+        // @note column components are returned as a copy, change them through patch or a view's columns
+        template <typename U>
+        decltype(auto) get(entity_type entity) {
+            if constexpr (component_traits<U>::track_changes) {
+                pool<U>().touch(entity.id(), tick_);
+            }
+
+            return pool<U>().get(entity.id());
+        }
+
+        template <typename U>
+        decltype(auto) get(entity_type entity) const {
+            return pool<U>().get(entity.id());
+        }
+
+        template <typename U>
+        void remove(entity_type entity) {
+            if (!contains(entity) || !signatures_[entity.id()].test(typeIndexer_.template index<U>())) {
+                return;
+            }
+
+            erase<U>(entity.id());
+        }
+
+        // @brief provides a sink notified after a component is added to an entity
+        // @note sinks are bound to this registry and must not outlive it or be used after it moves
+        // @note listeners must not add component types the registry has not seen yet, prepare them ahead of time instead
+        template <typename U>
+        [[nodiscard]] sink_type on_construct() {
+            return sink_type(this, assureIndex<U>(), &registry::resolveSignal<&pool_type::onConstruct>);
+        }
+
+        // @brief provides a sink notified after a component is patched
+        template <typename U>
+        [[nodiscard]] sink_type on_update() {
+            return sink_type(this, assureIndex<U>(), &registry::resolveSignal<&pool_type::onUpdate>);
+        }
+
+        // @brief provides a sink notified before a component is removed, including when its entity is destroyed
+        template <typename U>
+        [[nodiscard]] sink_type on_destroy() {
+            return sink_type(this, assureIndex<U>(), &registry::resolveSignal<&pool_type::onDestroy>);
+        }
+
+        // @brief gives the number of entities that own the provided component
+        template <typename U>
+        [[nodiscard]] size_type size() {
+            return assure<U>().size();
+        }
+
+        // @brief gives the number of components of a type that fit before its pool allocates again
+        template <typename U>
+        [[nodiscard]] size_type capacity() {
+            return assure<U>().capacity();
+        }
+
+        // @brief allocates space for at least the provided number of components
+        template <typename U>
+        void reserve(size_type capacity) {
+            assure<U>().reserve(capacity);
+        }
+
+        // @brief sorts the components of a type with a provided algorithm and condition
+        // @note pools owned by a group cannot be sorted, as the group relies on their order
+        // @note P is the condition, as C already names the component capacity
+        template <typename U, typename S, typename P>
+        void sort() {
+            static_assert(!is_soa_component<U>, "column components can only be sorted with sort_as");
+
+            auto& sparseSet = assure<U>();
+
+            assert(pools_[typeIndexer_.template index<U>()].owner == pool_type::no_owner && "cannot sort a pool owned by a group");
+
+            sparseSet.template sort<S, P>();
+        }
+
+        // @brief reorders the components of a type to follow the entity order of another type
+        // @note pools owned by a group cannot be sorted, as the group relies on their order
+        template <typename U, typename V>
+        void sort_as() {
+            auto& sparseSet = assure<U>();
+            auto& other = assure<V>();
+
+            assert(pools_[typeIndexer_.template index<U>()].owner == pool_type::no_owner && "cannot sort a pool owned by a group");
+
+            sparseSet.sort_as(other);
+        }
+
+        // @brief gives the tick changes are currently recorded at
+        [[nodiscard]] size_type tick() const {
+            return tick_;
+        }
+
+        // @brief moves on to the next tick, so later changes are newer than every tick handed out so far
+        // @note a system typically remembers tick() after it runs, calls advance(), and filters by the remembered tick next time
+        size_type advance() {
+            return ++tick_;
+        }
+
+        // @brief appends every entity and the provided components to a flat binary buffer
+        // @note components must be trivially copyable, their arrays are written exactly as they sit in memory
+        template <typename... Us>
+        requires((is_trivially_copyable<Us> && !is_soa_component<Us>) && ...)
+        void snapshot(list<uint8, uint64>& output) const {
+            snapshot_writer writer(output);
+
+            snapshot_header header;
+            header.sizeTypeBytes = sizeof(size_type);
+            header.entities = entities_.size();
+            header.freeEntities = entityFreeList_.size();
+            header.tick = tick_;
+            header.components = sizeof...(Us);
+
+            uint64 bytes = snapshot_writer::bound<snapshot_header>(1);
+            bytes += snapshot_writer::bound<entity_type>(entities_.size());
+            bytes += snapshot_writer::bound<size_type>(entityFreeList_.size());
+
+            writer.reserve((bytes + ... + snapshotBound<Us>()));
+
+            writer.write(header);
+            writer.write(entities_.data(), entities_.size());
+            writer.write(entityFreeList_.data(), entityFreeList_.size());
+
+            (snapshotComponent<Us>(writer), ...);
+        }
+
+        // @brief rebuilds entities and the provided components from a buffer written by snapshot<Us...>()
+        // @returns false if the registry is not empty or has groups, or if the buffer is malformed or was written for other components
+        // @note no signals fire while loading
+        // @note component arrays are copied in bulk straight from the buffer, which may be a mapped file
+        template <typename... Us>
+        requires((is_trivially_copyable<Us> && !is_soa_component<Us>) && ...)
+        [[nodiscard]] bool restore(span<const uint8, uint64> input) {
+            if (!entities_.empty() || !groupLengths_.empty()) {
+                return false;
+            }
+
+            snapshot_reader reader(input);
+            snapshot_header header;
+
+            if (!readSnapshotHeader(reader, header, sizeof...(Us))) {
+                return false;
+            }
+
+            size_type count = static_cast<size_type>(header.entities);
+            size_type freeCount = static_cast<size_type>(header.freeEntities);
+
+            const entity_type* entities = reader.template section<entity_type>(count);
+            const size_type* freeEntities = reader.template section<size_type>(freeCount);
+
+            if (reader.failed() || !validEntities(entities, count, freeEntities, freeCount)) {
+                return false;
+            }
+
+            snapshot_reader validator = reader;
+
+            if (!(restoreComponent<Us, false>(validator, entities, count) && ...)) {
+                return false;
+            }
+
+            entities_.resize(count);
+            entityFreeList_.resize(freeCount);
+            signatures_.resize(count);
+
+            copyBytes(entities_.data(), entities, sizeof(entity_type) * count);
+            copyBytes(entityFreeList_.data(), freeEntities, sizeof(size_type) * freeCount);
+
+            tick_ = static_cast<size_type>(header.tick);
+
+            (restoreComponent<Us, true>(reader, entities, count), ...);
+
+            return true;
+        }
+
+        // @brief appends what changed between a snapshot<Us...>() taken earlier and the current state
+        // @returns false if the baseline is malformed, was written for other components, or is newer than this registry
+        // @note ids are written as runs of varints and only components whose bytes changed are written, so the size follows the changes
+        template <typename... Us>
+        requires((is_trivially_copyable<Us> && !is_soa_component<Us>) && ...)
+        [[nodiscard]] bool delta(span<const uint8, uint64> baseline, list<uint8, uint64>& output) const {
+            snapshot_reader reader(baseline);
+            snapshot_header header;
+
+            if (!readSnapshotHeader(reader, header, sizeof...(Us))) {
+                return false;
+            }
+
+            size_type baseCount = static_cast<size_type>(header.entities);
+
+            const entity_type* baseEntities = reader.template section<entity_type>(baseCount);
+            const size_type* baseFreeEntities = reader.template section<size_type>(static_cast<size_type>(header.freeEntities));
+
+            if (reader.failed() || baseFreeEntities == nullptr || baseCount > entities_.size()) {
+                return false;
+            }
+
+            uint64 start = output.size();
+            snapshot_writer writer(output);
+
+            delta_header changes;
+            changes.sizeTypeBytes = sizeof(size_type);
+            changes.baseEntities = baseCount;
+            changes.entities = entities_.size();
+            changes.tick = tick_;
+            changes.components = sizeof...(Us);
+
+            writer.write(changes);
+
+            list<size_type, size_type> changed;
+
+            for (size_type id = 0; id < entities_.size(); id++) {
+                if (id >= baseCount || entities_[id] != baseEntities[id]) {
+                    changed.emplace(id);
+                }
+            }
+
+            writer.write_runs(changed.data(), changed.size());
+
+            for (size_type id : changed) {
+                writer.write_varint(entities_[id].value());
+            }
+
+            writer.write_varint(entityFreeList_.size());
+
+            for (size_type id : entityFreeList_) {
+                writer.write_varint(id);
+            }
+
+            if (!(deltaComponent<Us>(reader, writer, baseEntities, baseCount) && ...)) {
+                output.resize(start);
+
+                return false;
+            }
+
+            return true;
+        }
+
+        // @brief brings a registry in the state of a delta's baseline to the state the delta was taken in
+        // @returns false if the delta is malformed, was written for other components, or for another baseline size
+        // @note the whole delta is validated first, so a failed apply leaves the registry untouched
+        // @note components are removed, constructed and updated through the usual paths, so groups and signals stay in sync
+        template <typename... Us>
+        requires((is_trivially_copyable<Us> && !is_soa_component<Us>) && ...)
+        [[nodiscard]] bool apply_delta(span<const uint8, uint64> input) {
+            snapshot_reader reader(input);
+            delta_header header;
+
+            if (!reader.read(header)) {
+                return false;
+            }
+
+            bool matches = header.magic == delta_header::expected_magic && header.version == delta_header::current_version;
+
+            if (!matches || header.sizeTypeBytes != sizeof(size_type) || header.components != sizeof...(Us)) {
+                return false;
+            }
+
+            if (header.baseEntities != entities_.size() || header.entities < header.baseEntities || header.entities >= entity_type::dead_sentinel) {
+                return false;
+            }
+
+            size_type count = static_cast<size_type>(header.entities);
+
+            list<size_type, size_type> changed;
+            list<entity_type, size_type> values;
+            list<size_type, size_type> freeEntities;
+            uint64 freeCount = 0;
+
+            bool valid = reader.read_runs([&](uint64 id) {
+                changed.emplace(static_cast<size_type>(id));
+
+                return id < count;
+            });
+
+            // @note a slot either holds its own id or the dead index once destroyed
+            for (size_type i = 0; valid && i < changed.size(); i++) {
+                uint64 value = 0;
+
+                valid = reader.read_varint(value) && static_cast<size_type>(value) == value;
+
+                entity_type& entity = values.emplace(static_cast<size_type>(value));
+
+                valid = valid && (entity.id() == changed[i] || entity.id() == entity_type::dead_sentinel);
+            }
+
+            valid = valid && reader.read_varint(freeCount) && freeCount <= count;
+
+            for (uint64 i = 0; valid && i < freeCount; i++) {
+                uint64 id = 0;
+
+                valid = reader.read_varint(id) && id < count;
+                freeEntities.emplace(static_cast<size_type>(id));
+            }
+
+            snapshot_reader validator = reader;
+
+            if (!valid || !(deltaApply<Us, delta_pass::validate>(validator, count) && ...)) {
+                return false;
+            }
+
+            snapshot_reader upserts = reader;
+
+            (deltaApply<Us, delta_pass::remove>(reader, count), ...);
+
+            entities_.resize(count);
+            signatures_.resize(count);
+
+            for (size_type i = 0; i < changed.size(); i++) {
+                entities_[changed[i]] = values[i];
+            }
+
+            entityFreeList_ = spark::move(freeEntities);
+            tick_ = static_cast<size_type>(header.tick);
+
+            (deltaApply<Us, delta_pass::upsert>(upserts, count), ...);
+
+            return true;
+        }
+
+        // @brief creates the pools for the provided components ahead of time
+        // @note lookups of prepared components never allocate, so concurrent systems can share the registry
+        template <typename... Us>
+        void prepare() {
+            (assure<Us>(), ...);
+        }
+
+        // @brief provides a view over every entity that owns all of the provided components
+        // @note views are invalidated by structural changes, so take one per iteration
+        template <typename... Us>
+        requires(sizeof...(Us) > 0)
+        [[nodiscard]] ::spark::view<size_type, I, Us...> view() {
+            (assure<Us>(), ...);
+
+            return ::spark::view<size_type, I, Us...>(entities_, pool<Us>()...);
+        }
+
+        // @brief provides a group that keeps the owned pools packed in matching order
+        // @note a component can be owned by at most one group, and the first call pays for sorting existing members
+        // @note owned pools are reordered as entities enter and leave the group
+        template <typename... Os, typename... Gs, typename... Es>
+        requires(sizeof...(Os) > 0)
+        [[nodiscard]] ::spark::group<size_type, I, owned_t<Os...>, get_t<Gs...>, exclude_t<Es...>> group(get_t<Gs...> = get_t<Gs...>{}, exclude_t<Es...> = exclude_t<Es...>{}) {
+            using group_type = ::spark::group<size_type, I, owned_t<Os...>, get_t<Gs...>, exclude_t<Es...>>;
+
+            (assure<Os>(), ...);
+            (assure<Gs>(), ...);
+            (assure<Es>(), ...);
+
+            size_type groupIndex = groupIndexer_.template index<group_type>();
+
+            if (groupIndex + 1 > groupLengths_.size()) {
+                groupLengths_.resize(groupIndex + 1, 0);
+
+                (claimPool<Os>(groupIndex), ...);
+
+                (connectHook<Os>(groupIndex, &registry::groupInsert<void, owned_t<Os...>, get_t<Gs...>, exclude_t<Es...>>, &registry::groupDiscard<Os...>), ...);
+                (connectHook<Gs>(groupIndex, &registry::groupInsert<void, owned_t<Os...>, get_t<Gs...>, exclude_t<Es...>>, &registry::groupDiscard<Os...>), ...);
+                (connectHook<Es>(groupIndex, &registry::groupDiscard<Os...>, &registry::groupInsert<Es, owned_t<Os...>, get_t<Gs...>, exclude_t<Es...>>), ...);
+
+                auto& lead = pool<first_of<Os...>>();
+
+                for (size_type i = 0; i < lead.size(); i++) {
+                    groupInsert<void, owned_t<Os...>, get_t<Gs...>, exclude_t<Es...>>(this, groupIndex, lead.indices()[i]);
+                }
+            }
+
+            return group_type(entities_, groupLengths_[groupIndex], pool<Os>()..., pool<Gs>()...);
+        }
+
+    private:
+        using pool_type = ::spark::pool<size_type, I>;
+        using hook_type = pool_type::hook;
+        using signal_type = pool_type::signal_type;
+
+        template <typename U>
+        component_storage<U, size_type>& assure() {
+            using sparse_set_type = component_storage<U, size_type>;
 
             size_type typeIndex = typeIndexer_.template index<U>();
 
-            if (typeIndex + 1 > sparseSets_.size()) {
-                sparseSets_.resize(typeIndex + 1);
-                sparseSetDestructors_.resize(typeIndex + 1);
+            if (typeIndex + 1 > pools_.size()) {
+                pools_.resize(typeIndex + 1);
+            }
+
+            auto& record = pools_[typeIndex];
+
+            if (record.destructSparseSet == nullptr) {
+                static_assert(sizeof(sparse_set_type) <= sizeof(record.sparseSetFiller));
+
+                assert(typeIndex < C && "registry component capacity exceeded");
+
+                new (static_cast<void*>(&record.sparseSetFiller)) sparse_set_type();
 
-                new (&sparseSets_[typeIndex]) sparse_set<U, size_type>();
+                record.destructSparseSet = [](void* filler) {
+                    reinterpret_cast<sparse_set_type*>(filler)->~sparse_set_type();
+                };
 
-                sparseSetDestructors_[typeIndex] = [](void* ptr) {
-                    reinterpret_cast<sparse_set_type*>(ptr)->~sparse_set_type();
+                record.removeComponent = [](void* owner, size_type id) {
+                    static_cast<registry*>(owner)->template erase<U>(id);
                 };
             }
 
-            auto& sparseSetBytes = sparseSets_[typeIndex];
-            auto& sparseSet = *reinterpret_cast<sparse_set_type*>(&sparseSetBytes);
+            return pool<U>();
+        }
+
+        // @brief gives an upper bound of the bytes a component section takes
+        template <typename U>
+        [[nodiscard]] uint64 snapshotBound() const {
+            using storage_type = component_storage<U, size_type>;
+
+            const component_storage<U, size_type>* sparseSet = findPool<U>();
+            size_type count = sparseSet != nullptr ? sparseSet->size() : 0;
+
+            uint64 bytes = snapshot_writer::bound<snapshot_component_header>(1) + snapshot_writer::bound<size_type>(count);
+
+            if constexpr (storage_type::stores_elements) {
+                bytes += snapshot_writer::bound<U>(count);
+            }
+
+            if constexpr (storage_type::stores_ticks) {
+                bytes += snapshot_writer::bound<typename storage_type::ticks>(count);
+            }
 
-            if (!sparseSet.contains(entity.id_)) {
-                sparseSet.insert(entity.id_, forward<Args>(args)...);
+            return bytes;
+        }
+
+        template <typename U>
+        void snapshotComponent(snapshot_writer& writer) const {
+            using storage_type = component_storage<U, size_type>;
+
+            const storage_type* sparseSet = findPool<U>();
+            bool present = sparseSet != nullptr;
+
+            snapshot_component_header header;
+            header.elementBytes = storage_type::stores_elements ? sizeof(U) : 0;
+            header.elementAlignment = alignof(U);
+            header.count = present ? sparseSet->size() : 0;
+            header.tickBytes = storage_type::stores_ticks ? sizeof(typename storage_type::ticks) : 0;
+
+            writer.write(header);
+
+            if (!present) {
+                return;
             }
 
-            return sparseSet.get(entity.id_);
+            writer.write(sparseSet->indices().data(), sparseSet->size());
+
+            if constexpr (storage_type::stores_elements && storage_type::contiguous) {
+                writer.write(sparseSet->data(), sparseSet->size());
+            }
+            else if constexpr (storage_type::stores_elements) {
+                writer.template write<U>(sparseSet->size(), [sparseSet](U* destination) {
+                    sparseSet->copy_to(destination);
+                });
+            }
+
+            if constexpr (storage_type::stores_ticks) {
+                writer.write(sparseSet->tick_data(), sparseSet->size());
+            }
         }
 
+        // @brief the arrays of one component within a snapshot, pointing into the buffer
         template <typename U>
-        U& get(entity_type entity) {
-            using sparse_set_type = sparse_set<U, size_type>;
+        struct snapshot_section {
+            using ticks_type = component_storage<U, size_type>::ticks;
 
-            size_type typeIndex = typeIndexer_.template index<U>();
+            size_type count = 0;
+
+            const size_type* indices = nullptr;
+            const U* elements = nullptr;
+            const ticks_type* ticks = nullptr;
+        };
+
+        enum class delta_pass : uint8 {
+            validate,
+            remove,
+            upsert
+        };
+
+        // @note empty lists have no storage, so empty copies are skipped rather than handed null pointers
+        static void copyBytes(void* target, const void* source, uint64 bytes) {
+            if (bytes > 0) {
+                std::memcpy(target, source, bytes);
+            }
+        }
+
+        static bool readSnapshotHeader(snapshot_reader& reader, snapshot_header& header, uint64 components) {
+            if (!reader.read(header)) {
+                return false;
+            }
 
-            auto& sparseSetBytes = sparseSets_[typeIndex];
-            auto& sparseSet = *reinterpret_cast<sparse_set_type*>(&sparseSetBytes);
+            bool matches = header.magic == snapshot_header::expected_magic && header.version == snapshot_header::current_version;
 
-            return sparseSet.get(entity.id_);
+            return matches && header.sizeTypeBytes == sizeof(size_type) && header.components == components;
         }
 
+        // @brief checks the entity and free-list sections describe a registry create() can carry on from
+        // @note every slot must hold a live entity under its own id or a dead one, and the free list must name every dead slot exactly once
+        static bool validEntities(const entity_type* entities, size_type count, const size_type* freeEntities, size_type freeCount) {
+            if (count >= entity_type::dead_sentinel || freeCount > count) {
+                return false;
+            }
+
+            size_type dead = 0;
+
+            for (size_type id = 0; id < count; id++) {
+                size_type slot = entities[id].id();
+
+                if (slot == entity_type::dead_sentinel) {
+                    dead++;
+                }
+                else if (slot != id) {
+                    return false;
+                }
+            }
+
+            if (dead != freeCount) {
+                return false;
+            }
+
+            bitset listed(count);
+
+            for (size_type i = 0; i < freeCount; i++) {
+                size_type id = freeEntities[i];
+
+                if (id >= count || entities[id].id() != entity_type::dead_sentinel || listed.test(id)) {
+                    return false;
+                }
+
+                listed.set(id, true);
+            }
+
+            return true;
+        }
+
+        // @brief locates the next component section, checking it matches U and names every live entity at most once
         template <typename U>
-        const U& get(entity_type entity) const {
-            using sparse_set_type = sparse_set<U, size_type>;
+        static bool readSection(snapshot_reader& reader, snapshot_section<U>& section, const entity_type* entities, size_type entityCount) {
+            using storage_type = component_storage<U, size_type>;
+            using ticks_type = snapshot_section<U>::ticks_type;
 
-            size_type typeIndex = typeIndexer_.template index<U>();
+            snapshot_component_header header;
+
+            if (!reader.read(header)) {
+                return false;
+            }
+
+            bool elementsMatch = header.elementBytes == (storage_type::stores_elements ? sizeof(U) : 0) && header.elementAlignment == alignof(U);
+            bool ticksMatch = header.tickBytes == (storage_type::stores_ticks ? sizeof(ticks_type) : 0);
+
+            if (!elementsMatch || !ticksMatch || header.count > entityCount) {
+                return false;
+            }
 
-            auto& sparseSetBytes = sparseSets_[typeIndex];
-            auto& sparseSet = *reinterpret_cast<sparse_set_type*>(&sparseSetBytes);
+            section.count = static_cast<size_type>(header.count);
+            section.indices = reader.template section<size_type>(section.count);
 
-            return sparseSet.get(entity.id_);
+            if constexpr (storage_type::stores_elements) {
+                section.elements = reader.template section<U>(section.count);
+            }
+
+            if constexpr (storage_type::stores_ticks) {
+                section.ticks = reader.template section<ticks_type>(section.count);
+            }
+
+            if (reader.failed()) {
+                return false;
+            }
+
+            bitset seen(entityCount);
+
+            for (size_type i = 0; i < section.count; i++) {
+                size_type id = section.indices[i];
+
+                if (id >= entityCount || entities[id].id() != id || seen.test(id)) {
+                    return false;
+                }
+
+                seen.set(id, true);
+            }
+
+            return true;
+        }
+
+        // @brief reads one component section, and only loads it once A is set
+        // @note the whole buffer is validated with A unset first, so a failed restore leaves the registry untouched
+        template <typename U, bool A>
+        bool restoreComponent(snapshot_reader& reader, const entity_type* entities, size_type entityCount) {
+            using storage_type = component_storage<U, size_type>;
+
+            snapshot_section<U> section;
+
+            if (!readSection(reader, section, entities, entityCount)) {
+                return false;
+            }
+
+            if constexpr (A) {
+                auto& sparseSet = assure<U>();
+                size_type typeIndex = typeIndexer_.template index<U>();
+
+                sparseSet.assign(section.indices, section.count);
+
+                if constexpr (storage_type::stores_elements) {
+                    sparseSet.copy_from(section.elements);
+                }
+
+                if constexpr (storage_type::stores_ticks) {
+                    copyBytes(sparseSet.tick_data(), section.ticks, sizeof(*section.ticks) * section.count);
+                }
+
+                for (size_type i = 0; i < section.count; i++) {
+                    signatures_[section.indices[i]].set(typeIndex, true);
+                }
+            }
+
+            return true;
         }
 
+        // @brief writes the removed ids, then the added or modified ids and their elements, of one component
+        // @note a component of a recycled id is written as removed and added again, even if its bytes match
         template <typename U>
-        void remove(entity_type entity) {
-            using sparse_set_type = sparse_set<U, size_type>;
+        bool deltaComponent(snapshot_reader& reader, snapshot_writer& writer, const entity_type* baseEntities, size_type baseCount) const {
+            using storage_type = component_storage<U, size_type>;
+
+            snapshot_section<U> section;
+
+            if (!readSection(reader, section, baseEntities, baseCount)) {
+                return false;
+            }
+
+            list<size_type, size_type> basePositions;
+            basePositions.resize(baseCount, storage_type::dead_index);
+
+            for (size_type i = 0; i < section.count; i++) {
+                basePositions[section.indices[i]] = i;
+            }
+
+            const storage_type* current = findPool<U>();
+
+            list<size_type, size_type> removed;
+            list<size_type, size_type> upserted;
+
+            for (size_type id = 0; id < entities_.size(); id++) {
+                bool inBase = id < baseCount && basePositions[id] != storage_type::dead_index;
+                bool inCurrent = current != nullptr && current->contains(id);
+                bool recycled = id < baseCount && entities_[id].generation() != baseEntities[id].generation();
+
+                if (inBase && (!inCurrent || recycled)) {
+                    removed.emplace(id);
+                }
+
+                if (!inCurrent) {
+                    continue;
+                }
+
+                bool modified = !inBase || recycled;
+
+                if constexpr (storage_type::stores_elements) {
+                    modified = modified || std::memcmp(&current->get(id), &section.elements[basePositions[id]], sizeof(U)) != 0;
+                }
+
+                if (modified) {
+                    upserted.emplace(id);
+                }
+            }
+
+            writer.write_varint(storage_type::stores_elements ? sizeof(U) : 0);
+            writer.write_runs(removed.data(), removed.size());
+            writer.write_runs(upserted.data(), upserted.size());
 
+            if constexpr (storage_type::stores_elements) {
+                for (size_type id : upserted) {
+                    writer.write_bytes(&current->get(id), sizeof(U));
+                }
+            }
+
+            return true;
+        }
+
+        // @brief reads the delta of one component, validating it, applying its removals or applying its upserts
+        template <typename U, delta_pass P>
+        bool deltaApply(snapshot_reader& reader, size_type entityCount) {
+            using storage_type = component_storage<U, size_type>;
+
+            constexpr uint64 elementBytes = storage_type::stores_elements ? sizeof(U) : 0;
+
+            uint64 bytes = 0;
+
+            if (!reader.read_varint(bytes) || bytes != elementBytes) {
+                return false;
+            }
+
+            // @note removed ids must exist before the delta, and the registry still has its old size until upserts
+            bool removals = reader.read_runs([&](uint64 id) {
+                if (id >= entities_.size()) {
+                    return false;
+                }
+
+                if constexpr (P == delta_pass::remove) {
+                    if (signatures_[static_cast<size_type>(id)].test(typeIndexer_.template index<U>())) {
+                        erase<U>(static_cast<size_type>(id));
+                    }
+                }
+
+                return true;
+            });
+
+            list<size_type, size_type> upserted;
+
+            bool upserts = removals && reader.read_runs([&](uint64 id) {
+                upserted.emplace(static_cast<size_type>(id));
+
+                return id < entityCount;
+            });
+
+            if (!upserts) {
+                return false;
+            }
+
+            if constexpr (P != delta_pass::upsert) {
+                return reader.read_bytes(nullptr, elementBytes * upserted.size());
+            }
+            else {
+                for (size_type id : upserted) {
+                    upsert<U>(reader, id);
+                }
+
+                return true;
+            }
+        }
+
+        // @brief overwrites a component in place, or constructs it if the entity does not own one
+        template <typename U>
+        void upsert(snapshot_reader& reader, size_type id) {
+            using storage_type = component_storage<U, size_type>;
+
+            entity_type entity = entities_[id];
+
+            if constexpr (!storage_type::stores_elements) {
+                emplace<U>(entity);
+            }
+            else {
+                alignas(U) uint8 storage[sizeof(U)];
+
+                reader.read_bytes(storage, sizeof(U));
+
+                const U& value = *std::launder(reinterpret_cast<const U*>(storage));
+
+                if (!signatures_[id].test(typeIndexer_.template index<U>())) {
+                    emplace<U>(entity, value);
+                    return;
+                }
+
+                patch<U>(entity, [&](U& component) {
+                    std::memcpy(static_cast<void*>(&component), &value, sizeof(U));
+                });
+            }
+        }
+
+        template <typename U>
+        size_type assureIndex() {
+            assure<U>();
+
+            return typeIndexer_.template index<U>();
+        }
+
+        template <signal_type pool_type::* S>
+        static signal_type& resolveSignal(void* owner, size_type typeIndex) {
+            return static_cast<registry*>(owner)->pools_[typeIndex].*S;
+        }
+
+        // @note a single branch when nothing is connected
+        static void notify(signal_type& target, entity_type entity) {
+            if (!target.empty()) {
+                target.dispatch(entity);
+            }
+        }
+
+        // @brief removes a component known to be present, notifying listeners and groups first
+        template <typename U>
+        void erase(size_type id) {
             size_type typeIndex = typeIndexer_.template index<U>();
 
-            if (typeIndex + 1 > sparseSets_.size()) {
+            notify(pools_[typeIndex].onDestroy, entities_[id]);
+
+            for (auto& hook : pools_[typeIndex].destroyHooks) {
+                hook.call(this, hook.group, id);
+            }
+
+            pool<U>().remove(id);
+            signatures_[id].set(typeIndex, false);
+        }
+
+        template <typename U>
+        component_storage<U, size_type>& pool() {
+            auto& filler = pools_[typeIndexer_.template index<U>()].sparseSetFiller;
+
+            return *reinterpret_cast<component_storage<U, size_type>*>(&filler);
+        }
+
+        template <typename U>
+        const component_storage<U, size_type>& pool() const {
+            auto& filler = pools_[typeIndexer_.template find<U>()].sparseSetFiller;
+
+            return *reinterpret_cast<const component_storage<U, size_type>*>(&filler);
+        }
+
+        // @returns nullptr if the registry has never seen the component
+        template <typename U>
+        const component_storage<U, size_type>* findPool() const {
+            size_type typeIndex = typeIndexer_.template find<U>();
+
+            if (typeIndex >= pools_.size() || pools_[typeIndex].destructSparseSet == nullptr) {
+                return nullptr;
+            }
+
+            return &pool<U>();
+        }
+
+        template <typename U>
+        void claimPool(size_type groupIndex) {
+            auto& record = pools_[typeIndexer_.template index<U>()];
+
+            assert(record.owner == pool_type::no_owner && "component is already owned by another group");
+
+            record.owner = groupIndex;
+        }
+
+        template <typename U>
+        void connectHook(size_type groupIndex, hook_type::call_function onConstruct, hook_type::call_function onDestroy) {
+            auto& record = pools_[typeIndexer_.template index<U>()];
+
+            record.constructHooks.emplace(groupIndex, onConstruct);
+            record.destroyHooks.emplace(groupIndex, onDestroy);
+        }
+
+        // @brief moves an entity into the packed region of a group if it now qualifies
+        // @note R names an excluded component that is about to be removed, and is ignored
+        template <typename R, typename O, typename G, typename E>
+        static void groupInsert(void* owner, size_type groupIndex, size_type id) {
+            [&]<typename... Os, typename... Gs, typename... Es>(owned_t<Os...>, get_t<Gs...>, exclude_t<Es...>) {
+                auto& self = *static_cast<registry*>(owner);
+
+                bool owned = (self.template pool<Os>().contains(id) && ...);
+                bool observed = (self.template pool<Gs>().contains(id) && ...);
+                bool excluded = ((!is_same<Es, R> && self.template pool<Es>().contains(id)) || ...);
+
+                if (!owned || !observed || excluded) {
+                    return;
+                }
+
+                size_type& length = self.groupLengths_[groupIndex];
+
+                if (self.template pool<first_of<Os...>>().position(id) < length) {
+                    return;
+                }
+
+                (self.template packAt<Os>(id, length), ...);
+
+                length++;
+            }(O{}, G{}, E{});
+        }
+
+        // @brief moves an entity out of the packed region of a group if it is a member
+        template <typename... Os>
+        static void groupDiscard(void* owner, size_type groupIndex, size_type id) {
+            auto& self = *static_cast<registry*>(owner);
+
+            size_type& length = self.groupLengths_[groupIndex];
+
+            auto& lead = self.template pool<first_of<Os...>>();
+
+            if (!lead.contains(id) || lead.position(id) >= length) {
                 return;
             }
 
-            auto& sparseSetBytes = sparseSets_[typeIndex];
-            auto& sparseSet = *reinterpret_cast<sparse_set_type*>(&sparseSetBytes);
+            length--;
 
-            sparseSet.remove(entity.id_);
+            (self.template packAt<Os>(id, length), ...);
         }
 
-    private:
-        using sparse_set_filler = filler<sizeof(sparse_set<size_type, size_type>), alignof(sparse_set<size_type, size_type>)>;
-        using destructor_function = void (*)(void*);
+        template <typename U>
+        void packAt(size_type id, size_type position) {
+            auto& sparseSet = pool<U>();
+
+            sparseSet.swap(id, sparseSet.indices()[position]);
+        }
 
-        list<destructor_function, size_type> sparseSetDestructors_;
-        list<sparse_set_filler, size_type> sparseSets_;
+        list<pool_type, size_type> pools_;
 
         list<size_type, size_type> entityFreeList_;
         list<entity_type, size_type> entities_;
+        list<signature_type, size_type> signatures_;
+
+        list<size_type, size_type> groupLengths_;
+
+        // @note starts past zero, so filtering by tick zero matches every tracked component
+        size_type tick_ = 1;
 
         type_indexer<size_type> typeIndexer_;
+        type_indexer<size_type> groupIndexer_;
     };
 }
\ No newline at end of file
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <atomic>
+
+#include <spark/types/core.hpp>
+#include <spark/types/index.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/ecs/bitset.hpp>
+#include <spark/ecs/registry.hpp>
+
+#include <spark/threading/job_system.hpp>
+
+namespace spark {
+    // @brief declares components a system only reads
+    template <typename... Ts>
+    struct reads {};
+
+    // @brief declares components a system reads and writes
+    template <typename... Ts>
+    struct writes {};
+
+    // @brief runs systems concurrently whenever their declared component access does not conflict
+    // @note systems that conflict run in the order they were added
+    // @note systems must not make structural changes to the registry, record them in a command buffer instead
+    template <typename T = uint64, uint64 C = 128, uint64 I = default_index_bits<T>>
+    requires(is_unsigned<T>)
+    class scheduler {
+    public:
+        using size_type = T;
+        using registry_type = registry<size_type, C, I>;
+
+        scheduler() = default;
+        ~scheduler() = default;
+
+        scheduler(const scheduler&) = delete;
+        scheduler(scheduler&&) noexcept = default;
+
+        scheduler& operator=(const scheduler&) = delete;
+        scheduler& operator=(scheduler&&) noexcept = default;
+
+        // @brief adds a free function system taking (registry&)
+        // @note access is declared with any number of reads<...> and writes<...>
+        template <auto Fn, typename... Access>
+        void add() {
+            system& instance = acquire<Access...>();
+
+            instance.instance = nullptr;
+            instance.invoke = [](void*, registry_type& owner) {
+                Fn(owner);
+            };
+        }
+
+        // @brief adds a member function system taking (registry&)
+        // @note access is declared with any number of reads<...> and writes<...>
+        template <auto Fn, typename... Access, typename O>
+        void add(O& caller) {
+            system& instance = acquire<Access...>();
+
+            instance.instance = &caller;
+            instance.invoke = [](void* object, registry_type& owner) {
+                (static_cast<O*>(object)->*Fn)(owner);
+            };
+        }
+
+        // @brief removes every system
+        void clear() {
+            systems_.clear();
+            indexer_.reset();
+            dirty_ = true;
+        }
+
+        // @brief gives the number of systems
+        [[nodiscard]] size_type size() const {
+            return systems_.size();
+        }
+
+        // @brief runs every system once and returns when all have finished
+        void run(registry_type& owner, job_system& jobs) {
+            if (systems_.empty()) {
+                return;
+            }
+
+            if (dirty_) {
+                build();
+            }
+
+            for (auto& instance : systems_) {
+                instance.prepare(owner);
+                instance.remaining.store(instance.predecessors, std::memory_order_relaxed);
+            }
+
+            job_counter counter(systems_.size());
+            frame context{this, &owner, &jobs, &counter};
+
+            for (size_type i = 0; i < systems_.size(); i++) {
+                if (systems_[i].predecessors == 0) {
+                    jobs.submit(task(context, i));
+                }
+            }
+
+            jobs.wait(counter);
+        }
+
+    private:
+        struct system {
+            using invoke_function = void (*)(void*, registry_type&);
+            using prepare_function = void (*)(registry_type&);
+
+            system() = default;
+
+            // @note only valid while the scheduler is not running
+            system(system&& other) noexcept
+                : instance(other.instance), invoke(other.invoke), prepare(other.prepare),
+                  readMask(spark::move(other.readMask)), writeMask(spark::move(other.writeMask)),
+                  successors(spark::move(other.successors)), predecessors(other.predecessors) {
+            }
+
+            void* instance = nullptr;
+            invoke_function invoke = nullptr;
+            prepare_function prepare = nullptr;
+
+            bitset readMask;
+            bitset writeMask;
+
+            list<size_type, size_type> successors;
+            size_type predecessors = 0;
+
+            std::atomic<size_type> remaining = 0;
+        };
+
+        struct frame {
+            scheduler* self;
+            registry_type* owner;
+            job_system* jobs;
+            job_counter* counter;
+        };
+
+        template <typename... Access>
+        system& acquire() {
+            system& instance = systems_.emplace();
+
+            (declare(instance, Access{}), ...);
+
+            instance.prepare = [](registry_type& owner) {
+                (prepareAccess(owner, Access{}), ...);
+            };
+
+            dirty_ = true;
+
+            return instance;
+        }
+
+        template <typename... Ts>
+        void declare(system& instance, reads<Ts...>) {
+            (instance.readMask.set(indexer_.template index<Ts>(), true), ...);
+        }
+
+        template <typename... Ts>
+        void declare(system& instance, writes<Ts...>) {
+            (instance.writeMask.set(indexer_.template index<Ts>(), true), ...);
+        }
+
+        template <template <typename...> typename A, typename... Ts>
+        static void prepareAccess(registry_type& owner, A<Ts...>) {
+            owner.template prepare<Ts...>();
+        }
+
+        // @brief two systems conflict when either writes a component the other touches
+        [[nodiscard]] static bool conflicts(const system& a, const system& b) {
+            return (a.writeMask & (b.readMask | b.writeMask)).any() || (b.writeMask & a.readMask).any();
+        }
+
+        // @brief links every system to the later systems it conflicts with
+        void build() {
+            for (auto& instance : systems_) {
+                instance.successors.clear();
+                instance.predecessors = 0;
+            }
+
+            for (size_type i = 0; i < systems_.size(); i++) {
+                for (size_type j = i + 1; j < systems_.size(); j++) {
+                    if (conflicts(systems_[i], systems_[j])) {
+                        systems_[i].successors.emplace(j);
+                        systems_[j].predecessors++;
+                    }
+                }
+            }
+
+            dirty_ = false;
+        }
+
+        static job task(frame& context, size_type index) {
+            job work;
+
+            work.invoke = &scheduler::execute;
+            work.data = &context;
+            work.index = index;
+            work.counter = context.counter;
+
+            return work;
+        }
+
+        // @brief runs one system, then releases any successors it was the last dependency of
+        static void execute(void* data, uint64 index) {
+            auto& context = *static_cast<frame*>(data);
+            auto& instance = context.self->systems_[static_cast<size_type>(index)];
+
+            instance.invoke(instance.instance, *context.owner);
+
+            for (size_type next : instance.successors) {
+                auto& target = context.self->systems_[next];
+
+                if (target.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    context.jobs->submit(task(context, next));
+                }
+            }
+        }
+
+        list<system, size_type> systems_;
+        type_indexer<size_type> indexer_;
+
+        bool dirty_ = true;
+    };
+}
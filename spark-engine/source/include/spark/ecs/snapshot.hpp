@@ -0,0 +1,288 @@
+#pragma once
+
+#include <cstring>
+
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/span.hpp>
+
+namespace spark {
+    // @brief leading record of a registry snapshot
+    struct snapshot_header {
+        static constexpr uint64 expected_magic = 0x5350524B534E4150; // SPRKSNAP
+        static constexpr uint32 current_version = 1;
+
+        uint64 magic = expected_magic;
+        uint32 version = current_version;
+        uint32 sizeTypeBytes = 0;
+
+        uint64 entities = 0;
+        uint64 freeEntities = 0;
+        uint64 tick = 0;
+        uint64 components = 0;
+    };
+
+    // @brief leading record of a single component section within a registry snapshot
+    struct snapshot_component_header {
+        uint64 elementBytes = 0;
+        uint64 elementAlignment = 0;
+        uint64 count = 0;
+        uint64 tickBytes = 0;
+    };
+
+    // @brief leading record of a delta between a registry snapshot and a later state
+    struct delta_header {
+        static constexpr uint64 expected_magic = 0x5350524B44454C54; // SPRKDELT
+        static constexpr uint32 current_version = 1;
+
+        uint64 magic = expected_magic;
+        uint32 version = current_version;
+        uint32 sizeTypeBytes = 0;
+
+        uint64 baseEntities = 0;
+        uint64 entities = 0;
+        uint64 tick = 0;
+        uint64 components = 0;
+    };
+
+    // @brief appends aligned sections to a byte buffer
+    // @note sections start at multiples of section_alignment, so an aligned buffer or mapped file is readable in place
+    class snapshot_writer {
+    public:
+        static constexpr uint64 section_alignment = 16;
+
+        explicit snapshot_writer(list<uint8, uint64>& output)
+            : output_(&output) {
+        }
+
+        // @brief gives an upper bound of the bytes a section of count elements adds
+        template <typename T>
+        [[nodiscard]] static constexpr uint64 bound(uint64 count) {
+            return section_alignment + sizeof(T) * count;
+        }
+
+        // @brief allocates space for at least the provided number of additional bytes
+        void reserve(uint64 bytes) {
+            output_->reserve(output_->size() + bytes);
+        }
+
+        // @brief appends a copy of the provided elements, starting a new section
+        template <typename T>
+        void write(const T* data, uint64 count) {
+            static_assert(alignof(T) <= section_alignment, "snapshot sections cannot hold over-aligned types");
+
+            uint64 offset = align(output_->size());
+            uint64 bytes = sizeof(T) * count;
+
+            output_->resize(offset + bytes, 0);
+
+            if (bytes > 0) {
+                std::memcpy(output_->data() + offset, data, bytes);
+            }
+        }
+
+        // @brief appends a section of count elements, filled in place by the callable
+        // @param callable taking a T* to count uninitialized elements, valid until the next write
+        template <typename T, typename F>
+        void write(uint64 count, F&& fill) {
+            static_assert(alignof(T) <= section_alignment, "snapshot sections cannot hold over-aligned types");
+
+            uint64 offset = align(output_->size());
+
+            output_->resize(offset + sizeof(T) * count, 0);
+
+            if (count > 0) {
+                fill(reinterpret_cast<T*>(output_->data() + offset));
+            }
+        }
+
+        template <typename T>
+        void write(const T& value) {
+            write(&value, 1);
+        }
+
+        // @brief appends an unsigned integer in seven bit groups, so small values take a single byte
+        void write_varint(uint64 value) {
+            while (value >= 0x80) {
+                output_->emplace(static_cast<uint8>(value | 0x80));
+                value >>= 7;
+            }
+
+            output_->emplace(static_cast<uint8>(value));
+        }
+
+        // @brief appends raw bytes without aligning them
+        void write_bytes(const void* data, uint64 bytes) {
+            uint64 offset = output_->size();
+
+            output_->resize(offset + bytes, 0);
+
+            if (bytes > 0) {
+                std::memcpy(output_->data() + offset, data, bytes);
+            }
+        }
+
+        // @brief appends ascending ids as runs of consecutive ids, each a gap and a length
+        template <typename T>
+        void write_runs(const T* ids, uint64 count) {
+            uint64 runs = 0;
+
+            for (uint64 i = 0; i < count; i++) {
+                if (i == 0 || ids[i] != ids[i - 1] + 1) {
+                    runs++;
+                }
+            }
+
+            write_varint(runs);
+
+            uint64 next = 0;
+
+            for (uint64 i = 0; i < count;) {
+                uint64 length = 1;
+
+                while (i + length < count && ids[i + length] == ids[i] + length) {
+                    length++;
+                }
+
+                write_varint(ids[i] - next);
+                write_varint(length);
+
+                next = ids[i] + length;
+                i += length;
+            }
+        }
+
+    private:
+        static uint64 align(uint64 offset) {
+            return (offset + section_alignment - 1) & ~(section_alignment - 1);
+        }
+
+        list<uint8, uint64>* output_;
+    };
+
+    // @brief reads the sections a snapshot_writer appended, in place
+    // @note the input must start at a multiple of section_alignment, as buffers from list, operator new and mmap do
+    // @note reads past the end fail instead of touching memory, and every later read fails too
+    class snapshot_reader {
+    public:
+        explicit snapshot_reader(span<const uint8, uint64> input)
+            : input_(input) {
+            failed_ = reinterpret_cast<uint64>(input_.data()) % snapshot_writer::section_alignment != 0;
+        }
+
+        // @brief provides the next section without copying it
+        // @returns nullptr if the input is too short
+        template <typename T>
+        [[nodiscard]] const T* section(uint64 count) {
+            uint64 offset = (offset_ + snapshot_writer::section_alignment - 1) & ~(snapshot_writer::section_alignment - 1);
+
+            if (failed_ || offset > input_.size() || count > (input_.size() - offset) / sizeof(T)) {
+                failed_ = true;
+
+                return nullptr;
+            }
+
+            offset_ = offset + sizeof(T) * count;
+
+            return reinterpret_cast<const T*>(input_.data() + offset);
+        }
+
+        // @brief copies the next single-element section
+        template <typename T>
+        bool read(T& value) {
+            const T* source = section<T>(1);
+
+            if (source == nullptr) {
+                return false;
+            }
+
+            std::memcpy(static_cast<void*>(&value), source, sizeof(T));
+
+            return true;
+        }
+
+        bool read_varint(uint64& value) {
+            value = 0;
+
+            for (uint64 shift = 0; shift < 64; shift += 7) {
+                uint8 byte = 0;
+
+                if (!read_bytes(&byte, 1)) {
+                    return false;
+                }
+
+                value |= static_cast<uint64>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0) {
+                    return true;
+                }
+            }
+
+            failed_ = true;
+
+            return false;
+        }
+
+        // @brief copies raw bytes that were appended without alignment
+        // @param data may be nullptr to skip the bytes
+        bool read_bytes(void* data, uint64 bytes) {
+            if (failed_ || bytes > input_.size() - offset_) {
+                failed_ = true;
+
+                return false;
+            }
+
+            if (data != nullptr && bytes > 0) {
+                std::memcpy(data, input_.data() + offset_, bytes);
+            }
+
+            offset_ += bytes;
+
+            return true;
+        }
+
+        // @brief reads ids written by write_runs, invoking the callable for each in ascending order
+        // @param callable taking (id) and returning false to reject it, which fails the reader
+        template <typename F>
+        bool read_runs(F&& callable) {
+            uint64 runs = 0;
+            uint64 next = 0;
+
+            if (!read_varint(runs)) {
+                return false;
+            }
+
+            for (uint64 i = 0; i < runs; i++) {
+                uint64 gap = 0;
+                uint64 length = 0;
+
+                if (!read_varint(gap) || !read_varint(length) || gap > ~next || length > ~(next + gap)) {
+                    failed_ = true;
+
+                    return false;
+                }
+
+                for (uint64 id = next + gap; id < next + gap + length; id++) {
+                    if (!callable(id)) {
+                        failed_ = true;
+
+                        return false;
+                    }
+                }
+
+                next += gap + length;
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool failed() const {
+            return failed_;
+        }
+
+    private:
+        span<const uint8, uint64> input_;
+        uint64 offset_ = 0;
+        bool failed_ = false;
+    };
+}
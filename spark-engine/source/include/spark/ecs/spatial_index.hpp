@@ -0,0 +1,265 @@
+#pragma once
+
+#include <cassert>
+
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/span.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/values.hpp>
+
+#include <spark/ecs/component.hpp>
+#include <spark/ecs/entity.hpp>
+#include <spark/ecs/registry.hpp>
+
+namespace spark {
+    // @brief uniform grid over two coordinates of a component, answering radius and box queries
+    // @note X and Y name the coordinate members, e.g. &Position::x and &Position::z for a ground plane
+    // @note entities are bucketed per cell with a copy of their coordinates, so queries only read the cells they overlap
+    // @note positions outside the bounds land in the border cells and are still found
+    // @note construction, patch and removal keep the grid in sync, other writes are picked up by refresh
+    template <auto X, auto Y, typename T = uint64, uint64 C = 128, uint64 I = default_index_bits<T>>
+    requires(is_same<member_owner<X>, member_owner<Y>> && is_floating_point<member_type<X>> && is_floating_point<member_type<Y>> && is_unsigned<T>)
+    class spatial_index {
+    public:
+        using size_type = T;
+        using entity_type = entity<size_type, I>;
+        using registry_type = registry<size_type, C, I>;
+        using component_type = member_owner<X>;
+
+        // @brief an entity and the coordinates it was last indexed at
+        struct entry {
+            entity_type entity;
+            float32 x;
+            float32 y;
+        };
+
+        spatial_index(registry_type& owner, float32 minX, float32 minY, float32 maxX, float32 maxY, float32 cellSize)
+            : registry_(&owner), minX_(minX), minY_(minY), inverseCellSize_(1.0f / cellSize) {
+            assert(cellSize > 0.0f && maxX > minX && maxY > minY && "spatial index needs a positive cell size and non-empty bounds");
+
+            columns_ = static_cast<size_type>((maxX - minX) * inverseCellSize_) + 1;
+            rows_ = static_cast<size_type>((maxY - minY) * inverseCellSize_) + 1;
+
+            cells_.resize(columns_ * rows_);
+
+            registry_->template on_construct<component_type>().template connect<&spatial_index::onConstruct>(*this);
+            registry_->template on_update<component_type>().template connect<&spatial_index::onUpdate>(*this);
+            registry_->template on_destroy<component_type>().template connect<&spatial_index::onDestroy>(*this);
+
+            registry_->template view<component_type>().each([this](entity_type entity, const component_type& component) {
+                place(entity, coordinate<X>(component), coordinate<Y>(component));
+            });
+
+            if constexpr (component_traits<component_type>::track_changes) {
+                seen_ = registry_->tick() - 1;
+            }
+        }
+
+        ~spatial_index() {
+            registry_->template on_construct<component_type>().template disconnect<&spatial_index::onConstruct>(*this);
+            registry_->template on_update<component_type>().template disconnect<&spatial_index::onUpdate>(*this);
+            registry_->template on_destroy<component_type>().template disconnect<&spatial_index::onDestroy>(*this);
+        }
+
+        spatial_index(const spatial_index&) = delete;
+        spatial_index(spatial_index&&) = delete;
+
+        spatial_index& operator=(const spatial_index&) = delete;
+        spatial_index& operator=(spatial_index&&) = delete;
+
+        // @brief re-reads coordinates that may have been written without patch
+        // @note components that track changes only revisit those changed since the last refresh, advancing the tick is left to the frame owner
+        // @note entities that stay within their cell only have their stored coordinates updated
+        void refresh() {
+            auto update = [this](entity_type entity, const component_type& component) {
+                place(entity, coordinate<X>(component), coordinate<Y>(component));
+            };
+
+            if constexpr (component_traits<component_type>::track_changes) {
+                registry_->template view<component_type>().template changed<component_type>(seen_).each(update);
+
+                seen_ = registry_->tick() - 1;
+            }
+            else {
+                registry_->template view<component_type>().each(update);
+            }
+        }
+
+        // @brief provides every entity within the radius of a point
+        // @note the span is reused by the next query
+        [[nodiscard]] span<const entity_type, size_type> query(float32 x, float32 y, float32 radius) {
+            float32 radiusSquared = radius * radius;
+
+            return collect(x - radius, y - radius, x + radius, y + radius, [&](const entry& candidate) {
+                float32 dx = candidate.x - x;
+                float32 dy = candidate.y - y;
+
+                return dx * dx + dy * dy <= radiusSquared;
+            });
+        }
+
+        // @brief provides every entity within a box, edges included
+        // @note the span is reused by the next query
+        [[nodiscard]] span<const entity_type, size_type> query(float32 minX, float32 minY, float32 maxX, float32 maxY) {
+            return collect(minX, minY, maxX, maxY, [&](const entry& candidate) {
+                return candidate.x >= minX && candidate.x <= maxX && candidate.y >= minY && candidate.y <= maxY;
+            });
+        }
+
+        // @brief provides the entries of the cell holding a point
+        [[nodiscard]] span<const entry, size_type> cell(float32 x, float32 y) const {
+            const auto& bucket = cells_[cellOf(x, y)];
+
+            return span<const entry, size_type>(bucket.data(), bucket.size());
+        }
+
+        // @brief gives the number of indexed entities
+        [[nodiscard]] size_type size() const {
+            return count_;
+        }
+
+    private:
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // @brief where an entity sits, by id
+        struct slot {
+            size_type cell = npos;
+            size_type position = 0;
+        };
+
+        template <auto M>
+        static float32 coordinate(const component_type& component) {
+            return static_cast<float32>(component.*M);
+        }
+
+        [[nodiscard]] size_type column(float32 x) const {
+            return clamp((x - minX_) * inverseCellSize_, columns_);
+        }
+
+        [[nodiscard]] size_type row(float32 y) const {
+            return clamp((y - minY_) * inverseCellSize_, rows_);
+        }
+
+        // @note clamps before converting, so far away or infinite coordinates land in the border cells
+        [[nodiscard]] static size_type clamp(float32 offset, size_type count) {
+            if (!(offset > 0.0f)) {
+                return 0;
+            }
+
+            if (offset >= static_cast<float32>(count - 1)) {
+                return count - 1;
+            }
+
+            return static_cast<size_type>(offset);
+        }
+
+        [[nodiscard]] size_type cellOf(float32 x, float32 y) const {
+            return row(y) * columns_ + column(x);
+        }
+
+        template <typename F>
+        span<const entity_type, size_type> collect(float32 minX, float32 minY, float32 maxX, float32 maxY, F&& accepts) {
+            results_.clear();
+
+            size_type firstColumn = column(minX);
+            size_type lastColumn = column(maxX);
+            size_type lastRow = row(maxY);
+
+            for (size_type y = row(minY); y <= lastRow; y++) {
+                for (size_type x = firstColumn; x <= lastColumn; x++) {
+                    for (const entry& candidate : cells_[y * columns_ + x]) {
+                        if (accepts(candidate)) {
+                            results_.emplace(candidate.entity);
+                        }
+                    }
+                }
+            }
+
+            return span<const entity_type, size_type>(results_.data(), results_.size());
+        }
+
+        // @brief inserts an entity or moves it to the cell of its new coordinates
+        void place(entity_type entity, float32 x, float32 y) {
+            size_type id = entity.id();
+
+            if (id >= slots_.size()) {
+                slots_.resize(id + 1);
+            }
+
+            slot& current = slots_[id];
+            size_type target = cellOf(x, y);
+
+            if (current.cell == target) {
+                entry& indexed = cells_[target][current.position];
+
+                indexed.x = x;
+                indexed.y = y;
+
+                return;
+            }
+
+            if (current.cell != npos) {
+                unplace(id);
+            }
+            else {
+                count_++;
+            }
+
+            current.cell = target;
+            current.position = cells_[target].size();
+
+            cells_[target].emplace(entry{entity, x, y});
+        }
+
+        // @brief takes an entity out of its cell, moving the cell's last entry into the hole
+        void unplace(size_type id) {
+            slot& current = slots_[id];
+            auto& bucket = cells_[current.cell];
+
+            entry& last = bucket.last();
+
+            slots_[last.entity.id()].position = current.position;
+            bucket[current.position] = last;
+            bucket.pop();
+
+            current.cell = npos;
+        }
+
+        void onConstruct(const entity_type& entity) {
+            decltype(auto) component = static_cast<const registry_type&>(*registry_).template get<component_type>(entity);
+
+            place(entity, coordinate<X>(component), coordinate<Y>(component));
+        }
+
+        void onUpdate(const entity_type& entity) {
+            onConstruct(entity);
+        }
+
+        void onDestroy(const entity_type& entity) {
+            if (entity.id() < slots_.size() && slots_[entity.id()].cell != npos) {
+                unplace(entity.id());
+
+                count_--;
+            }
+        }
+
+        registry_type* registry_;
+
+        float32 minX_;
+        float32 minY_;
+        float32 inverseCellSize_;
+
+        size_type columns_ = 0;
+        size_type rows_ = 0;
+        size_type count_ = 0;
+
+        // @note the last tick whose writes refresh has seen, one behind the registry, as the current tick may still be written to
+        size_type seen_ = 0;
+
+        list<list<entry, size_type>, size_type> cells_;
+        list<slot, size_type> slots_;
+        list<entity_type, size_type> results_;
+    };
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/span.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/ecs/batch.hpp>
+#include <spark/ecs/component.hpp>
+#include <spark/ecs/entity.hpp>
+
+#include <spark/threading/job_system.hpp>
+
+#include <spark/utilities/simd.hpp>
+
+namespace spark {
+    // @brief iterates all entities that own every one of the provided components
+    // @note walks the smallest pool and probes the others, so cost scales with the rarest component
+    // @note invalidated by any structural change to the registry it was taken from
+    template <typename T, uint64 I, typename... Ts>
+    requires(is_unsigned<T> && sizeof...(Ts) > 0)
+    class view {
+    public:
+        using size_type = T;
+        using entity_type = entity<size_type, I>;
+
+        class iterator {
+        public:
+            iterator(const view* owner, size_type position)
+                : owner_(owner), position_(position) {
+                skip();
+            }
+
+            [[nodiscard]] entity_type operator*() const {
+                return (*owner_->entities_)[owner_->driver_[position_]];
+            }
+
+            iterator& operator++() {
+                position_++;
+                skip();
+
+                return *this;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& other) const {
+                return position_ == other.position_;
+            }
+
+            [[nodiscard]] bool operator!=(const iterator& other) const {
+                return position_ != other.position_;
+            }
+
+        private:
+            void skip() {
+                while (position_ < owner_->driver_.size() && !owner_->matches(owner_->driver_[position_])) {
+                    position_++;
+                }
+            }
+
+            const view* owner_;
+            size_type position_;
+        };
+
+        view(const list<entity_type, size_type>& entities, component_storage<Ts, size_type>&... pools)
+            : entities_(&entities), pools_(&pools...) {
+            driver_ = pools_.template get<first_of<Ts...>>().indices();
+
+            ((pools.size() < driver_.size() ? void(driver_ = pools.indices()) : void()), ...);
+        }
+
+        // @brief only keeps entities whose component changed after the provided tick
+        // @note the component must track changes, see component_traits
+        template <typename U>
+        requires(component_traits<U>::track_changes && (is_same<U, Ts> || ...))
+        view& changed(size_type since) & {
+            auto& condition = filters_.template get<U>();
+
+            condition.changedSince = condition.byChanged ? max(condition.changedSince, since) : since;
+            condition.byChanged = true;
+            filtered_ = true;
+
+            return *this;
+        }
+
+        template <typename U>
+        requires(component_traits<U>::track_changes && (is_same<U, Ts> || ...))
+        [[nodiscard]] view changed(size_type since) && {
+            return spark::move(this->changed<U>(since));
+        }
+
+        // @brief only keeps entities whose component was added after the provided tick
+        // @note the component must track changes, see component_traits
+        template <typename U>
+        requires(component_traits<U>::track_changes && (is_same<U, Ts> || ...))
+        view& added(size_type since) & {
+            auto& condition = filters_.template get<U>();
+
+            condition.addedSince = condition.byAdded ? max(condition.addedSince, since) : since;
+            condition.byAdded = true;
+            filtered_ = true;
+
+            return *this;
+        }
+
+        template <typename U>
+        requires(component_traits<U>::track_changes && (is_same<U, Ts> || ...))
+        [[nodiscard]] view added(size_type since) && {
+            return spark::move(this->added<U>(since));
+        }
+
+        // @brief checks if the entity owns every viewed component
+        [[nodiscard]] bool contains(entity_type entity) const {
+            return matches(entity.id());
+        }
+
+        // @brief provides a viewed component of an entity
+        // @note the entity must be contained in the view
+        // @note column components are returned as a copy
+        template <typename U>
+        [[nodiscard]] decltype(auto) get(entity_type entity) const {
+            return pools_.template get<U>().get(entity.id());
+        }
+
+        // @brief provides one field of a viewed column component for every entity that owns it
+        // @note the span follows the component's own dense order and may include entities outside the view
+        template <auto M>
+        requires(is_soa_component<member_owner<M>> && (is_same<member_owner<M>, Ts> || ...))
+        [[nodiscard]] span<member_type<M>, size_type> column() const {
+            return pools_.template get<member_owner<M>>().template column<M>();
+        }
+
+        // @brief gives the position of an entity's component within the columns of a column component
+        template <typename U>
+        requires(is_soa_component<U> && (is_same<U, Ts> || ...))
+        [[nodiscard]] size_type position(entity_type entity) const {
+            return pools_.template get<U>().position(entity.id());
+        }
+
+        // @brief gives the number of entities the view will visit at most
+        [[nodiscard]] size_type size_hint() const {
+            return static_cast<size_type>(driver_.size());
+        }
+
+        // @brief invokes the callable for every entity in the view
+        // @param callable taking (entity, Ts&...) or (Ts&...)
+        template <typename F>
+        void each(F&& callable) const {
+            for (size_type id : driver_) {
+                visit(id, callable);
+            }
+        }
+
+        // @brief invokes the callable for every entity in the view, spread across the job system
+        // @param job system to run on
+        // @param callable taking (entity, Ts&...) or (Ts&...), invoked concurrently
+        // @param number of driver elements handed to a job at once
+        // @note the callable must only write to the components it is given
+        template <typename F>
+        void par_each(job_system& jobs, F&& callable, uint64 grain = 1024) const {
+            jobs.parallel_for(driver_.size(), grain, [this, &callable](uint64 begin, uint64 end) {
+                for (uint64 i = begin; i < end; i++) {
+                    visit(driver_[i], callable);
+                }
+            });
+        }
+
+        // @brief invokes the kernel for every W entities in the view at once
+        // @param kernel taking (batch<size_type, I, W, Ts...>&), reading and writing whole fields as W-lane vectors
+        // @note every viewed component must be a column component, fields of entities that sit next to each other are moved in one copy
+        // @note the last batch may be partial, see batch::size
+        template <uint64 W = simd_width<float32>, typename F>
+        requires((is_soa_component<Ts> && ...))
+        void each_batch(F&& kernel) const {
+            batch<size_type, I, W, Ts...> lanes(*entities_, pools_.template get<Ts>()...);
+
+            for (size_type position = 0; position < driver_.size();) {
+                // @note runs where every pool holds the same entities in the same order skip the per-entity lookups
+                if (lanes.size() == 0 && lanes.pushRun(driver_.data() + position, position)) {
+                    kernel(lanes);
+                    lanes.flush();
+
+                    position += W;
+
+                    continue;
+                }
+
+                size_type id = driver_[position++];
+
+                if (!matches(id)) {
+                    continue;
+                }
+
+                lanes.push(id);
+
+                if (lanes.full()) {
+                    kernel(lanes);
+                    lanes.flush();
+                }
+            }
+
+            if (lanes.size() > 0) {
+                kernel(lanes);
+                lanes.flush();
+            }
+        }
+
+        [[nodiscard]] iterator begin() const {
+            return iterator(this, 0);
+        }
+
+        [[nodiscard]] iterator end() const {
+            return iterator(this, static_cast<size_type>(driver_.size()));
+        }
+
+    private:
+        template <typename U>
+        struct holder {
+            component_storage<U, size_type>* pool;
+        };
+
+        // @brief the tick conditions an entity's component has to pass on top of owning every component
+        // @note held inline for every viewed component, so filtering never allocates
+        template <typename U>
+        struct tick_filter {
+            size_type changedSince = 0;
+            size_type addedSince = 0;
+            bool byChanged = false;
+            bool byAdded = false;
+        };
+
+        struct filter_pack : tick_filter<Ts>... {
+            template <typename U>
+            tick_filter<U>& get() {
+                return static_cast<tick_filter<U>&>(*this);
+            }
+
+            template <typename U>
+            const tick_filter<U>& get() const {
+                return static_cast<const tick_filter<U>&>(*this);
+            }
+        };
+
+        struct pool_pack : holder<Ts>... {
+            explicit pool_pack(component_storage<Ts, size_type>*... pools)
+                : holder<Ts>{pools}... {
+            }
+
+            template <typename U>
+            component_storage<U, size_type>& get() const {
+                return *static_cast<const holder<U>&>(*this).pool;
+            }
+        };
+
+        template <typename F>
+        void visit(size_type id, F& callable) const {
+            if (!matches(id)) {
+                return;
+            }
+
+            if constexpr (requires { callable(entity_type(), pools_.template get<Ts>().get(id)...); }) {
+                callable((*entities_)[id], pools_.template get<Ts>().get(id)...);
+            }
+            else {
+                callable(pools_.template get<Ts>().get(id)...);
+            }
+        }
+
+        // @brief checks the entity's component against the tick conditions set for it
+        // @note compiles away for components that do not track changes
+        template <typename U>
+        [[nodiscard]] bool passes(size_type id) const {
+            if constexpr (component_traits<U>::track_changes) {
+                const auto& condition = filters_.template get<U>();
+
+                if (!condition.byChanged && !condition.byAdded) {
+                    return true;
+                }
+
+                const auto& ticks = pools_.template get<U>().ticks_of(id);
+
+                return (!condition.byChanged || ticks.changed > condition.changedSince) && (!condition.byAdded || ticks.added > condition.addedSince);
+            }
+            else {
+                return true;
+            }
+        }
+
+        // @note evaluates every probe without short-circuiting to keep the loop branch-light
+        [[nodiscard]] bool matches(size_type id) const {
+            bool owned = (static_cast<uint8>(pools_.template get<Ts>().contains(id)) & ...) != 0;
+
+            if (!owned || !filtered_) {
+                return owned;
+            }
+
+            return (passes<Ts>(id) && ...);
+        }
+
+        const list<entity_type, size_type>* entities_;
+        pool_pack pools_;
+        span<const size_type> driver_;
+
+        filter_pack filters_;
+        bool filtered_ = false;
+    };
+}
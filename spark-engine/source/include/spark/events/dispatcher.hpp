@@ -7,14 +7,29 @@
 #include <spark/events/sink.hpp>
 
 namespace spark {
-    template <typename T = uint64>
+    // @note queued events are stored in lists using the allocator, e.g. an arena_allocator over a per-frame linear_arena
+    // @note the arena can be reset once update or clear has emptied the queues
+    // @note N > 0 keeps up to N listeners per event type inside its signal, see signal
+    template <typename T = uint64, typename A = heap_allocator, uint64 N = 0>
     requires(is_unsigned<T>)
     class dispatcher {
     public:
         using size_type = T;
+        using allocator_type = A;
+        using family_type = family<size_type, allocator_type, N>;
+
+        template <typename U>
+        using signal_type = signal<U, size_type, N>;
+
+        template <typename U>
+        using queue_type = list<U, size_type, double_growth_policy, allocator_type>;
 
         dispatcher() = default;
 
+        explicit dispatcher(const allocator_type& allocator)
+            : allocator_(allocator) {
+        }
+
         ~dispatcher() {
             reset();
         }
@@ -26,28 +41,28 @@ namespace spark {
         dispatcher& operator=(dispatcher&&) noexcept = default;
 
         template <typename U>
-        sink<U, size_type> sink() {
+        sink<U, size_type, N> sink() {
             acquireFamily<U>();
 
             size_type index = indexer_.template index<U>();
 
-            return ::spark::sink<U, size_type>(families_, index);
+            return ::spark::sink<U, size_type, N>(&families_, index, &resolveSignal<U>);
         }
 
         template <typename U, typename... Args>
         void trigger(Args&&... args) {
-            signal<U, size_type>& instance = acquireSignal<U>();
+            signal_type<U>& instance = acquireSignal<U>();
 
-            U event(forward<Args>(args)...);
+            U event(spark::forward<Args>(args)...);
 
             instance.dispatch(event);
         }
 
         template <typename U, typename... Args>
         void enqueue(Args&&... args) {
-            list<U, size_type>& familyList = acquirelist<U>();
+            queue_type<U>& familyList = acquirelist<U>();
 
-            familyList.emplace(forward<Args>(args)...);
+            familyList.emplace(spark::forward<Args>(args)...);
         }
 
         void clear() {
@@ -84,7 +99,7 @@ namespace spark {
 
     private:
         template <typename U>
-        family<size_type>& acquireFamily() {
+        family_type& acquireFamily() {
             size_type index = indexer_.template index<U>();
 
             if (index + 1 > families_.size()) {
@@ -94,26 +109,26 @@ namespace spark {
             auto& delegate = families_[index];
 
             if (delegate.destructSignal == nullptr) {
-                new (static_cast<void*>(&delegate.signalFiller)) signal<U, size_type>();
+                new (static_cast<void*>(&delegate.signalFiller)) signal_type<U>();
 
                 delegate.destructSignal = [](void* filler) {
-                    auto& instance = *reinterpret_cast<signal<U, size_type>*>(filler);
+                    auto& instance = *reinterpret_cast<signal_type<U>*>(filler);
 
-                    instance.~signal<U, size_type>();
+                    instance.~signal_type<U>();
                 };
             }
 
             if (delegate.destructList == nullptr) {
-                new (static_cast<void*>(&delegate.listFiller)) list<U, size_type>();
+                new (static_cast<void*>(&delegate.listFiller)) queue_type<U>(allocator_);
 
                 delegate.destructList = [](void* filler) {
-                    auto& instance = *reinterpret_cast<list<U, size_type>*>(filler);
+                    auto& instance = *reinterpret_cast<queue_type<U>*>(filler);
 
-                    instance.~list<U, size_type>();
+                    instance.~queue_type<U>();
                 };
 
                 delegate.clearList = [](void* filler) {
-                    auto& instance = *reinterpret_cast<list<U, size_type>*>(filler);
+                    auto& instance = *reinterpret_cast<queue_type<U>*>(filler);
 
                     instance.clear();
                 };
@@ -121,8 +136,8 @@ namespace spark {
 
             if (delegate.dispatch == nullptr) {
                 delegate.dispatch = [](void* signalFiller, void* listFiller) {
-                    auto& signalInstance = *reinterpret_cast<signal<U, size_type>*>(signalFiller);
-                    auto& listInstance = *reinterpret_cast<list<U, size_type>*>(listFiller);
+                    auto& signalInstance = *reinterpret_cast<signal_type<U>*>(signalFiller);
+                    auto& listInstance = *reinterpret_cast<queue_type<U>*>(listFiller);
 
                     for (auto& event : listInstance) {
                         signalInstance.dispatch(event);
@@ -136,22 +151,31 @@ namespace spark {
         }
 
         template <typename U>
-        signal<U, size_type>& acquireSignal() {
+        signal_type<U>& acquireSignal() {
             auto& delegate = acquireFamily<U>();
-            auto& acquired = *reinterpret_cast<signal<U, size_type>*>(&delegate.signalFiller);
+            auto& acquired = *reinterpret_cast<signal_type<U>*>(&delegate.signalFiller);
 
             return acquired;
         }
 
         template <typename U>
-        list<U, size_type>& acquirelist() {
+        queue_type<U>& acquirelist() {
             auto& delegate = acquireFamily<U>();
-            auto& acquired = *reinterpret_cast<list<U, size_type>*>(&delegate.listFiller);
+            auto& acquired = *reinterpret_cast<queue_type<U>*>(&delegate.listFiller);
 
             return acquired;
         }
 
+        template <typename U>
+        static signal_type<U>& resolveSignal(void* owner, size_type index) {
+            auto& filler = (*static_cast<list<family_type, size_type>*>(owner))[index].signalFiller;
+
+            return *reinterpret_cast<signal_type<U>*>(&filler);
+        }
+
         type_indexer<size_type> indexer_;
-        list<family<size_type>, size_type> families_;
+        list<family_type, size_type> families_;
+
+        [[no_unique_address]] allocator_type allocator_;
     };
 }
\ No newline at end of file
@@ -3,16 +3,17 @@
 #include <spark/events/signal.hpp>
 
 namespace spark {
-    template <typename T = uint64>
+    template <typename T = uint64, typename A = heap_allocator, uint64 N = 0>
     requires(is_unsigned<T>)
     struct family {
         using size_type = T;
+        using allocator_type = A;
 
-        using signal_dummy = signal<size_type, size_type>;
+        using signal_dummy = signal<size_type, size_type, N>;
         using signal_filler = filler_of<signal_dummy>;
         using signal_destructor = void (*)(void*);
 
-        using list_dummy = list<size_type, size_type>;
+        using list_dummy = list<size_type, size_type, double_growth_policy, allocator_type>;
         using list_filler = filler_of<list_dummy>;
         using list_destructor = void (*)(void*);
         using list_clearer = void (*)(void*);
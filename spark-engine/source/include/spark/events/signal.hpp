@@ -3,18 +3,34 @@
 #include <spark/types/filler.hpp>
 #include <spark/types/index.hpp>
 #include <spark/types/list.hpp>
+#include <spark/types/small_list.hpp>
 #include <spark/types/traits.hpp>
 
 namespace spark {
+    namespace detail {
+        template <typename T, typename U, uint64 N>
+        struct delegate_list_selector {
+            using type = small_list<T, N, U>;
+        };
+
+        template <typename T, typename U>
+        struct delegate_list_selector<T, U, 0> {
+            using type = list<T, U>;
+        };
+    }
+
     // TODO: implement sinks, publish, trigger, and connect
     // GET READY FOR EnTT BENCHMARK
-    template <typename T, typename U = uint64>
+    // @note N > 0 keeps up to N listeners inside the signal itself, so dispatching to them reads no other memory
+    template <typename T, typename U = uint64, uint64 N = 0>
     requires(is_unsigned<U>)
     class signal {
     public:
         using event_type = T;
         using size_type = U;
 
+        static constexpr uint64 inline_listeners = N;
+
         signal() = default;
         ~signal() = default;
 
@@ -48,6 +64,11 @@ namespace spark {
             }
         }
 
+        // @brief checks if no listener is connected
+        [[nodiscard]] bool empty() const {
+            return delegates_.size() == delegateFreeList_.size();
+        }
+
         void clear() {
             delegates_.clear();
             delegateFreeList_.clear();
@@ -86,7 +107,7 @@ namespace spark {
                 bool sameInstance = instance.instance == target.instance;
 
                 if (sameCall && sameInstance) {
-                    invalidate(instance, i);
+                    invalidate(i);
 
                     break;
                 }
@@ -140,7 +161,7 @@ namespace spark {
             (object->*Fn)(*static_cast<const event_type*>(event));
         }
 
+        detail::delegate_list_selector<delegate, size_type, N>::type delegates_;
         list<size_type, size_type> delegateFreeList_;
-        list<delegate, size_type> delegates_;
     };
 }
\ No newline at end of file
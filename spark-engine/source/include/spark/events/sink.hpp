@@ -4,15 +4,23 @@
 #include <spark/events/signal.hpp>
 
 namespace spark {
-    template <typename T, typename U = uint64>
+    // @brief connects listeners to a signal that may move, by looking it up again on every call
+    template <typename T, typename U = uint64, uint64 N = 0>
     requires(is_unsigned<U>)
     class sink {
     public:
         using event_type = T;
         using size_type = U;
+        using signal_type = signal<event_type, size_type, N>;
+        using signal_resolver = signal_type& (*)(void*, size_type);
 
-        sink(list<family<size_type>, size_type>& families, size_type index)
-            : families_(&families), index_(index) {
+        sink(list<family<size_type, heap_allocator, N>, size_type>& families, size_type index)
+            : owner_(&families), index_(index), resolve_(&resolveFamily) {
+        }
+
+        // @param resolve provides the signal of the owner at the index
+        sink(void* owner, size_type index, signal_resolver resolve)
+            : owner_(owner), index_(index), resolve_(resolve) {
         }
 
         ~sink() = default;
@@ -58,14 +66,19 @@ namespace spark {
         }
 
     private:
-        signal<event_type, size_type>& acquire() {
-            auto& filler = (*families_)[index_].signalFiller;
-            auto& instance = *reinterpret_cast<signal<event_type, size_type>*>(&filler);
+        static signal_type& resolveFamily(void* owner, size_type index) {
+            auto& filler = (*static_cast<list<family<size_type, heap_allocator, N>, size_type>*>(owner))[index].signalFiller;
+            auto& instance = *reinterpret_cast<signal_type*>(&filler);
 
             return instance;
         }
 
-        list<family<size_type>, size_type>* families_;
+        signal_type& acquire() {
+            return resolve_(owner_, index_);
+        }
+
+        void* owner_;
         size_type index_;
+        signal_resolver resolve_;
     };
 }
\ No newline at end of file
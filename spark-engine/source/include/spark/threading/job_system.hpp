@@ -0,0 +1,239 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+
+#include <spark/threading/work_deque.hpp>
+
+namespace spark {
+    // @brief counts outstanding jobs, reaches zero once every job tied to it has finished
+    using job_counter = std::atomic<uint64>;
+
+    // @brief a type-erased unit of work
+    struct job {
+        using invoke_function = void (*)(void*, uint64);
+
+        invoke_function invoke = nullptr;
+        void* data = nullptr;
+        uint64 index = 0;
+
+        job_counter* counter = nullptr;
+    };
+
+    // @brief fixed pool of worker threads that balance load by stealing from each other
+    // @note each worker owns a lock-free deque; threads that wait on a counter run jobs instead of blocking
+    class job_system {
+    public:
+        // @param total number of threads doing work, including the thread that waits
+        explicit job_system(uint64 threads = std::thread::hardware_concurrency()) {
+            queues_.resize(max(threads, static_cast<uint64>(1)));
+
+            for (uint64 i = 1; i < queues_.size(); i++) {
+                workers_.emplace([this, i]() {
+                    run(i);
+                });
+            }
+        }
+
+        ~job_system() {
+            {
+                std::lock_guard lock(sleepMutex_);
+                stopping_ = true;
+            }
+
+            sleepCondition_.notify_all();
+
+            for (auto& worker : workers_) {
+                worker.join();
+            }
+        }
+
+        job_system(const job_system&) = delete;
+        job_system(job_system&&) = delete;
+
+        job_system& operator=(const job_system&) = delete;
+        job_system& operator=(job_system&&) = delete;
+
+        // @brief gives the number of threads doing work, including the waiting thread
+        [[nodiscard]] uint64 size() const {
+            return queues_.size();
+        }
+
+        // @brief gives the index of the calling thread within this system
+        // @note threads that are not workers of this system share index 0
+        [[nodiscard]] uint64 worker() const {
+            return currentSystem_ == this ? currentWorker_ : 0;
+        }
+
+        // @brief queues a job on the calling thread's deque
+        // @note the job's counter must already account for it
+        void submit(const job& work) {
+            pending_.fetch_add(1);
+
+            uint64 self = worker();
+
+            if (self == 0) {
+                std::lock_guard lock(sharedMutex_);
+                queues_[0].push(work);
+            }
+            else {
+                queues_[self].push(work);
+            }
+
+            if (sleeping_.load() > 0) {
+                std::lock_guard lock(sleepMutex_);
+                sleepCondition_.notify_one();
+            }
+        }
+
+        // @brief runs queued jobs until the counter reaches zero
+        void wait(const job_counter& counter) {
+            uint64 self = worker();
+
+            while (counter.load(std::memory_order_acquire) > 0) {
+                job work;
+
+                if (acquire(self, work)) {
+                    execute(work);
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // @brief splits [0, count) into chunks of grain and runs them across all threads
+        // @param callable taking (begin, end) for each chunk
+        // @note blocks until every chunk has finished, the caller works on chunks meanwhile
+        template <typename F>
+        void parallel_for(uint64 count, uint64 grain, F&& callable) {
+            if (count == 0) {
+                return;
+            }
+
+            grain = max(grain, static_cast<uint64>(1));
+
+            uint64 chunks = (count + grain - 1) / grain;
+
+            if (chunks == 1 || queues_.size() == 1) {
+                callable(static_cast<uint64>(0), count);
+                return;
+            }
+
+            struct context {
+                remove_reference<F>* callable;
+                uint64 count;
+                uint64 grain;
+            };
+
+            context shared{&callable, count, grain};
+            job_counter counter(chunks);
+
+            job work;
+            work.data = &shared;
+            work.counter = &counter;
+            work.invoke = [](void* data, uint64 index) {
+                auto& state = *static_cast<context*>(data);
+
+                uint64 begin = index * state.grain;
+                uint64 end = min(begin + state.grain, state.count);
+
+                (*state.callable)(begin, end);
+            };
+
+            for (uint64 i = chunks; i > 1; i--) {
+                work.index = i - 1;
+                submit(work);
+            }
+
+            work.index = 0;
+            execute(work);
+
+            wait(counter);
+        }
+
+    private:
+        void run(uint64 index) {
+            currentSystem_ = this;
+            currentWorker_ = index;
+
+            while (true) {
+                job work;
+
+                if (acquire(index, work)) {
+                    execute(work);
+                    continue;
+                }
+
+                std::unique_lock lock(sleepMutex_);
+
+                sleeping_.fetch_add(1);
+
+                sleepCondition_.wait(lock, [this]() {
+                    return stopping_ || pending_.load() > 0;
+                });
+
+                sleeping_.fetch_sub(1);
+
+                if (stopping_) {
+                    return;
+                }
+            }
+        }
+
+        // @brief takes a job from the thread's own deque, or steals one from another
+        bool acquire(uint64 self, job& work) {
+            bool found = pop(self, work);
+
+            for (uint64 i = 1; !found && i < queues_.size(); i++) {
+                found = queues_[(self + i) % queues_.size()].steal(work);
+            }
+
+            if (found) {
+                pending_.fetch_sub(1);
+            }
+
+            return found;
+        }
+
+        // @brief takes the most recent job from the thread's own deque
+        bool pop(uint64 self, job& work) {
+            if (self == 0) {
+                std::lock_guard lock(sharedMutex_);
+                return queues_[0].pop(work);
+            }
+
+            return queues_[self].pop(work);
+        }
+
+        static void execute(const job& work) {
+            work.invoke(work.data, work.index);
+
+            if (work.counter != nullptr) {
+                work.counter->fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+
+        list<work_deque<job>> queues_;
+        list<std::thread> workers_;
+
+        // @note threads that are not workers share deque 0, so they take turns on its owner end
+        std::mutex sharedMutex_;
+
+        // @note pending and sleeping pair up sequentially consistent so a submit never misses a sleeper
+        std::atomic<uint64> pending_ = 0;
+        std::atomic<uint64> sleeping_ = 0;
+
+        std::mutex sleepMutex_;
+        std::condition_variable sleepCondition_;
+        bool stopping_ = false;
+
+        inline static thread_local const job_system* currentSystem_ = nullptr;
+        inline static thread_local uint64 currentWorker_ = 0;
+    };
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/traits.hpp>
+
+namespace spark {
+    // @brief lock-free double-ended queue of work shared between one owner and many thieves
+    // @note the owner pushes and pops at the bottom (LIFO), thieves steal from the top (FIFO)
+    // @note Chase-Lev: only the owner moves the bottom, and the owner and thieves race for the top with a compare-exchange
+    // @note push and pop must only be called from the owning thread, or by callers that take turns under their own lock
+    // @note elements are copied in and out as relaxed atomic words, so T must be trivially copyable
+    template <typename T, typename U = uint64>
+    requires(is_unsigned<U> && is_trivially_copyable<T>)
+    class work_deque {
+    public:
+        using type = T;
+        using size_type = U;
+
+        work_deque() = default;
+
+        ~work_deque() {
+            for (ring* retired : rings_) {
+                delete retired;
+            }
+        }
+
+        work_deque(const work_deque&) = delete;
+
+        // @note only valid before the deque is shared between threads
+        work_deque(work_deque&& other) noexcept
+            : top_(other.top_.load(std::memory_order_relaxed)), bottom_(other.bottom_.load(std::memory_order_relaxed)),
+              ring_(other.ring_.load(std::memory_order_relaxed)), rings_(spark::move(other.rings_)) {
+            other.top_.store(0, std::memory_order_relaxed);
+            other.bottom_.store(0, std::memory_order_relaxed);
+            other.ring_.store(nullptr, std::memory_order_relaxed);
+        }
+
+        work_deque& operator=(const work_deque&) = delete;
+        work_deque& operator=(work_deque&&) = delete;
+
+        // @brief adds an element at the bottom of the deque
+        // @note owner only
+        void push(const type& value) {
+            int64 bottom = bottom_.load(std::memory_order_relaxed);
+            int64 top = top_.load(std::memory_order_acquire);
+            ring* current = ring_.load(std::memory_order_relaxed);
+
+            if (current == nullptr || bottom - top >= current->capacity) {
+                current = grow(current, top, bottom);
+            }
+
+            current->store(bottom, value);
+
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        // @brief takes the most recently pushed element
+        // @returns false if the deque was empty, or a thief took the last element first
+        // @note owner only
+        bool pop(type& value) {
+            int64 bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            ring* current = ring_.load(std::memory_order_relaxed);
+
+            // @note sequentially consistent with the loads in steal, so the owner and a thief never both miss each other's claim
+            bottom_.store(bottom, std::memory_order_seq_cst);
+
+            int64 top = top_.load(std::memory_order_seq_cst);
+
+            if (top > bottom) {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+
+                return false;
+            }
+
+            word packed[words];
+            current->load(bottom, packed);
+
+            if (top == bottom) {
+                // @note the last element, thieves may be going for it too
+                bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+
+                if (!won) {
+                    return false;
+                }
+            }
+
+            std::memcpy(static_cast<void*>(&value), packed, sizeof(type));
+
+            return true;
+        }
+
+        // @brief takes the least recently pushed element
+        // @returns false if the deque was empty, or another thread took the element first
+        // @note any thread
+        bool steal(type& value) {
+            int64 top = top_.load(std::memory_order_seq_cst);
+            int64 bottom = bottom_.load(std::memory_order_seq_cst);
+
+            if (top >= bottom) {
+                return false;
+            }
+
+            ring* current = ring_.load(std::memory_order_acquire);
+
+            word packed[words];
+            current->load(top, packed);
+
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return false;
+            }
+
+            std::memcpy(static_cast<void*>(&value), packed, sizeof(type));
+
+            return true;
+        }
+
+    private:
+        using word = uint64;
+
+        static constexpr uint64 words = (sizeof(type) + sizeof(word) - 1) / sizeof(word);
+
+        // @brief a power-of-two circular buffer holding each element as atomic words, so racing reads are well defined
+        struct ring {
+            explicit ring(int64 size)
+                : capacity(size), cells(new std::atomic<word>[static_cast<uint64>(size) * words]) {
+            }
+
+            ~ring() {
+                delete[] cells;
+            }
+
+            ring(const ring&) = delete;
+            ring& operator=(const ring&) = delete;
+
+            void store(int64 position, const type& value) {
+                word packed[words] = {};
+                std::memcpy(packed, static_cast<const void*>(&value), sizeof(type));
+
+                std::atomic<word>* cell = at(position);
+
+                for (uint64 i = 0; i < words; i++) {
+                    cell[i].store(packed[i], std::memory_order_relaxed);
+                }
+            }
+
+            void load(int64 position, word (&packed)[words]) const {
+                const std::atomic<word>* cell = at(position);
+
+                for (uint64 i = 0; i < words; i++) {
+                    packed[i] = cell[i].load(std::memory_order_relaxed);
+                }
+            }
+
+            [[nodiscard]] std::atomic<word>* at(int64 position) const {
+                return cells + static_cast<uint64>(position & (capacity - 1)) * words;
+            }
+
+            int64 capacity;
+            std::atomic<word>* cells;
+        };
+
+        // @brief replaces the ring with one twice the size, holding the same elements
+        // @note thieves may still be reading the old ring, so it is only freed with the deque
+        ring* grow(ring* current, int64 top, int64 bottom) {
+            auto* fresh = new ring(current == nullptr ? 64 : current->capacity * 2);
+
+            for (int64 i = top; i < bottom; i++) {
+                word packed[words];
+                current->load(i, packed);
+
+                std::atomic<word>* cell = fresh->at(i);
+
+                for (uint64 j = 0; j < words; j++) {
+                    cell[j].store(packed[j], std::memory_order_relaxed);
+                }
+            }
+
+            rings_.emplace(fresh);
+            ring_.store(fresh, std::memory_order_release);
+
+            return fresh;
+        }
+
+        // @note the ends sit on separate cache lines, as thieves hammer the top while the owner works the bottom
+        alignas(64) std::atomic<int64> top_ = 0;
+        alignas(64) std::atomic<int64> bottom_ = 0;
+
+        std::atomic<ring*> ring_ = nullptr;
+
+        // @note every ring allocated so far, touched by the owner only
+        list<ring*, size_type> rings_;
+    };
+}
\ No newline at end of file
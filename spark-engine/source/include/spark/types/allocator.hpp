@@ -0,0 +1,360 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <spark/types/core.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/values.hpp>
+
+namespace spark {
+    // @brief allocates through the global operator new, the default for every container
+    class heap_allocator {
+    public:
+        [[nodiscard]] void* allocate(uint64 bytes, uint64 alignment) {
+            if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                return operator new(bytes, std::align_val_t{alignment});
+            }
+
+            return operator new(bytes);
+        }
+
+        void deallocate(void* memory, uint64, uint64 alignment) noexcept {
+            if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                operator delete(memory, std::align_val_t{alignment});
+            }
+            else {
+                operator delete(memory);
+            }
+        }
+
+        [[nodiscard]] bool operator==(const heap_allocator&) const = default;
+    };
+
+    // @brief hands out memory from a fixed buffer by bumping an offset
+    // @note allocate returns nullptr once the buffer has no room left
+    // @note only the most recent allocation is given back on deallocation, everything else waits for reset
+    // @note reset releases everything at once, containers using the arena must be cleared or discarded first
+    class linear_arena {
+    public:
+        // @param capacity in bytes, allocated once from the heap
+        explicit linear_arena(uint64 capacity)
+            : buffer_(static_cast<uint8*>(operator new(capacity, std::align_val_t{max_alignment}))), capacity_(capacity), owned_(true) {
+        }
+
+        // @param external buffer the arena hands out, it must outlive the arena
+        linear_arena(void* buffer, uint64 capacity)
+            : buffer_(static_cast<uint8*>(buffer)), capacity_(capacity) {
+        }
+
+        ~linear_arena() {
+            if (owned_) {
+                operator delete(buffer_, std::align_val_t{max_alignment});
+            }
+        }
+
+        linear_arena(const linear_arena&) = delete;
+        linear_arena(linear_arena&&) = delete;
+
+        linear_arena& operator=(const linear_arena&) = delete;
+        linear_arena& operator=(linear_arena&&) = delete;
+
+        [[nodiscard]] void* allocate(uint64 bytes, uint64 alignment) {
+            uint64 address = reinterpret_cast<uint64>(buffer_) + offset_;
+            uint64 start = (address + alignment - 1) & ~(alignment - 1);
+            uint64 end = start - reinterpret_cast<uint64>(buffer_) + bytes;
+
+            if (end > capacity_) {
+                return nullptr;
+            }
+
+            offset_ = end;
+
+            return reinterpret_cast<void*>(start);
+        }
+
+        void deallocate(void* memory, uint64 bytes, uint64) noexcept {
+            if (static_cast<uint8*>(memory) + bytes == buffer_ + offset_) {
+                offset_ = static_cast<uint64>(static_cast<uint8*>(memory) - buffer_);
+            }
+        }
+
+        // @brief grows the most recent allocation in place
+        // @returns false if the allocation is not the most recent one or the buffer has no room left
+        [[nodiscard]] bool expand(void* memory, uint64 bytes, uint64 newBytes) noexcept {
+            uint64 start = static_cast<uint64>(static_cast<uint8*>(memory) - buffer_);
+
+            if (start + bytes != offset_ || start + newBytes > capacity_) {
+                return false;
+            }
+
+            offset_ = start + newBytes;
+
+            return true;
+        }
+
+        // @brief releases every allocation in constant time
+        void reset() {
+            offset_ = 0;
+        }
+
+        // @brief gives the number of bytes handed out, padding included
+        [[nodiscard]] uint64 used() const {
+            return offset_;
+        }
+
+        [[nodiscard]] uint64 capacity() const {
+            return capacity_;
+        }
+
+    private:
+        static constexpr uint64 max_alignment = 64;
+
+        uint8* buffer_;
+        uint64 capacity_;
+        uint64 offset_ = 0;
+        bool owned_ = false;
+    };
+
+    // @brief hands out memory by bumping an offset, chaining new blocks from the heap when the current one runs out
+    // @note deallocation is a no-op, reset keeps the largest block for reuse and frees the rest
+    class monotonic_arena {
+    public:
+        // @param size in bytes of the first block, later blocks double
+        explicit monotonic_arena(uint64 blockSize = 4096)
+            : nextSize_(max(blockSize, static_cast<uint64>(sizeof(block)))) {
+        }
+
+        ~monotonic_arena() {
+            release(nullptr);
+        }
+
+        monotonic_arena(const monotonic_arena&) = delete;
+        monotonic_arena(monotonic_arena&&) = delete;
+
+        monotonic_arena& operator=(const monotonic_arena&) = delete;
+        monotonic_arena& operator=(monotonic_arena&&) = delete;
+
+        [[nodiscard]] void* allocate(uint64 bytes, uint64 alignment) {
+            if (head_ != nullptr) {
+                uint64 address = reinterpret_cast<uint64>(head_) + offset_;
+                uint64 start = (address + alignment - 1) & ~(alignment - 1);
+
+                if (start + bytes <= reinterpret_cast<uint64>(head_) + head_->size) {
+                    offset_ = start + bytes - reinterpret_cast<uint64>(head_);
+
+                    return reinterpret_cast<void*>(start);
+                }
+            }
+
+            grow(bytes + alignment);
+
+            return allocate(bytes, alignment);
+        }
+
+        void deallocate(void*, uint64, uint64) noexcept {
+        }
+
+        // @brief grows the most recent allocation in place
+        // @returns false if the allocation is not the most recent one or the current block has no room left
+        [[nodiscard]] bool expand(void* memory, uint64 bytes, uint64 newBytes) noexcept {
+            if (head_ == nullptr) {
+                return false;
+            }
+
+            uint64 start = static_cast<uint64>(static_cast<uint8*>(memory) - reinterpret_cast<uint8*>(head_));
+
+            if (start + bytes != offset_ || start + newBytes > head_->size) {
+                return false;
+            }
+
+            offset_ = start + newBytes;
+
+            return true;
+        }
+
+        // @brief releases every allocation, keeping the most recent block for reuse
+        void reset() {
+            if (head_ == nullptr) {
+                return;
+            }
+
+            release(head_);
+
+            head_->next = nullptr;
+            offset_ = sizeof(block);
+        }
+
+    private:
+        static constexpr uint64 block_alignment = 64;
+
+        // @brief header at the start of every block
+        struct block {
+            block* next;
+            uint64 size;
+        };
+
+        void grow(uint64 bytes) {
+            uint64 size = max(nextSize_, bytes + sizeof(block));
+
+            auto* fresh = static_cast<block*>(operator new(size, std::align_val_t{block_alignment}));
+
+            fresh->next = head_;
+            fresh->size = size;
+
+            head_ = fresh;
+            offset_ = sizeof(block);
+            nextSize_ = size * 2;
+        }
+
+        // @brief frees every block past the provided one, or every block for nullptr
+        void release(block* kept) {
+            block* current = kept != nullptr ? kept->next : head_;
+
+            while (current != nullptr) {
+                block* next = current->next;
+
+                operator delete(current, std::align_val_t{block_alignment});
+
+                current = next;
+            }
+
+            if (kept == nullptr) {
+                head_ = nullptr;
+            }
+        }
+
+        block* head_ = nullptr;
+        uint64 offset_ = 0;
+        uint64 nextSize_;
+    };
+
+    // @brief hands out fixed-size blocks from chunks, recycling freed blocks through an intrusive free list
+    // @note allocate returns nullptr for requests larger or more aligned than the blocks the pool was created with
+    class block_pool {
+    public:
+        // @param block size in bytes
+        // @param block alignment
+        // @param blocks per chunk taken from the heap
+        explicit block_pool(uint64 blockSize, uint64 blockAlignment = alignof(std::max_align_t), uint64 blocksPerChunk = 64)
+            : alignment_(max(blockAlignment, static_cast<uint64>(alignof(void*)))), blocksPerChunk_(blocksPerChunk) {
+            uint64 size = max(blockSize, static_cast<uint64>(sizeof(void*)));
+
+            blockSize_ = (size + alignment_ - 1) & ~(alignment_ - 1);
+        }
+
+        ~block_pool() {
+            while (chunks_ != nullptr) {
+                void* next = *static_cast<void**>(chunks_);
+
+                operator delete(chunks_, std::align_val_t{alignment_});
+
+                chunks_ = next;
+            }
+        }
+
+        block_pool(const block_pool&) = delete;
+        block_pool(block_pool&&) = delete;
+
+        block_pool& operator=(const block_pool&) = delete;
+        block_pool& operator=(block_pool&&) = delete;
+
+        [[nodiscard]] void* allocate(uint64 bytes, uint64 alignment) {
+            if (bytes > blockSize_ || alignment > alignment_) {
+                return nullptr;
+            }
+
+            if (free_ == nullptr) {
+                grow();
+            }
+
+            void* memory = free_;
+            free_ = *static_cast<void**>(free_);
+
+            return memory;
+        }
+
+        void deallocate(void* memory, uint64, uint64) noexcept {
+            *static_cast<void**>(memory) = free_;
+            free_ = memory;
+        }
+
+        [[nodiscard]] uint64 block_size() const {
+            return blockSize_;
+        }
+
+    private:
+        // @note the first block of every chunk links the chunks together and is never handed out
+        void grow() {
+            auto* chunk = static_cast<uint8*>(operator new(blockSize_ * (blocksPerChunk_ + 1), std::align_val_t{alignment_}));
+
+            *reinterpret_cast<void**>(chunk) = chunks_;
+            chunks_ = chunk;
+
+            for (uint64 i = blocksPerChunk_; i > 0; i--) {
+                deallocate(chunk + i * blockSize_, blockSize_, alignment_);
+            }
+        }
+
+        void* chunks_ = nullptr;
+        void* free_ = nullptr;
+
+        uint64 blockSize_ = 0;
+        uint64 alignment_;
+        uint64 blocksPerChunk_;
+    };
+
+    // @brief takes memory from an allocator, terminating if it returns nullptr
+    // @note containers cannot report a failed allocation from their noexcept members, so an exhausted arena or an oversized pool request ends the program in every build type
+    template <typename A>
+    [[nodiscard]] inline void* allocate_or_abort(A& allocator, uint64 bytes, uint64 alignment) {
+        void* memory = allocator.allocate(bytes, alignment);
+
+        if (memory == nullptr) {
+            std::abort();
+        }
+
+        return memory;
+    }
+
+    // @brief allocator handle over an arena or pool, copied freely while the resource stays in place
+    // @note allocators may provide expand(memory, bytes, newBytes) to grow an allocation in place, lists of trivially relocatable elements use it
+    template <typename R>
+    class resource_allocator {
+    public:
+        using resource_type = R;
+
+        resource_allocator(resource_type& resource)
+            : resource_(&resource) {
+        }
+
+        [[nodiscard]] void* allocate(uint64 bytes, uint64 alignment) {
+            return resource_->allocate(bytes, alignment);
+        }
+
+        void deallocate(void* memory, uint64 bytes, uint64 alignment) noexcept {
+            resource_->deallocate(memory, bytes, alignment);
+        }
+
+        // @brief grows an allocation in place, for resources that support it
+        [[nodiscard]] bool expand(void* memory, uint64 bytes, uint64 newBytes) noexcept
+        requires(requires(R& resource, void* at, uint64 size) { resource.expand(at, size, size); }) {
+            return resource_->expand(memory, bytes, newBytes);
+        }
+
+        [[nodiscard]] resource_type& resource() const {
+            return *resource_;
+        }
+
+        [[nodiscard]] bool operator==(const resource_allocator&) const = default;
+
+    private:
+        resource_type* resource_;
+    };
+
+    using arena_allocator = resource_allocator<linear_arena>;
+    using monotonic_allocator = resource_allocator<monotonic_arena>;
+    using pool_allocator = resource_allocator<block_pool>;
+}
@@ -0,0 +1,382 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <new>
+
+#include <spark/types/core.hpp>
+#include <spark/types/filler.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/values.hpp>
+
+namespace spark {
+    // @brief 64-bit FNV-1a hash of a byte range, e.g. for hashing names into keys
+    [[nodiscard]] constexpr uint64 hash_bytes(const void* data, uint64 bytes) noexcept {
+        const auto* input = static_cast<const uint8*>(data);
+
+        uint64 hash = 0xCBF29CE484222325;
+
+        for (uint64 i = 0; i < bytes; i++) {
+            hash ^= input[i];
+            hash *= 0x100000001B3;
+        }
+
+        return hash;
+    }
+
+    // @brief hashes keys for hash_map
+    // @note covers every type whose bytes alone decide equality, such as integers, pointers, enums and entities
+    // @note keys of up to 8 bytes are passed through as is, hash_map spreads them before use
+    // @note specialise it for other keys
+    template <typename K>
+    struct hasher {
+        static_assert(__has_unique_object_representations(K), "keys without a unique object representation need a hasher specialisation");
+
+        [[nodiscard]] uint64 operator()(const K& key) const noexcept {
+            if constexpr (sizeof(K) <= sizeof(uint64)) {
+                uint64 value = 0;
+
+                std::memcpy(&value, &key, sizeof(K));
+
+                return value;
+            }
+            else {
+                return hash_bytes(&key, sizeof(K));
+            }
+        }
+    };
+
+    // @brief an unordered map with open addressing in flat arrays, so inserts do not allocate per element
+    // @note Robin Hood probing: an insert takes the slot of any element closer to its home slot, keeping probe lengths short and even
+    // @note removal shifts the following elements back a slot instead of leaving tombstones, so lookups never slow down over time
+    // @note a byte per slot holds the probe distance, lookups scan these bytes and only compare keys at matching distances
+    // @note inserting or removing may move elements, references are only valid until the next insert or removal
+    template <typename K, typename V, typename H = hasher<K>, typename U = uint64>
+    requires(is_unsigned<U>)
+    class hash_map {
+    public:
+        using key_type = K;
+        using value_type = V;
+        using hasher_type = H;
+        using size_type = U;
+
+        // @brief a key and its value, as stored in the map
+        struct entry {
+            key_type key;
+            value_type value;
+        };
+
+        hash_map() = default;
+
+        ~hash_map() {
+            clear();
+        }
+
+        hash_map(const hash_map& other)
+            : distances_(other.distances_), hasher_(other.hasher_), size_(other.size_), shift_(other.shift_) {
+            entries_.resize(other.entries_.size());
+
+            for (size_type i = 0; i < distances_.size(); i++) {
+                if (distances_[i] != vacant) {
+                    new (static_cast<void*>(&entries_[i])) entry(other.slot(i));
+                }
+            }
+        }
+
+        hash_map(hash_map&& other) noexcept
+            : distances_(spark::move(other.distances_)), entries_(spark::move(other.entries_)), hasher_(other.hasher_), size_(other.size_), shift_(other.shift_) {
+            other.size_ = 0;
+        }
+
+        hash_map& operator=(const hash_map& other) {
+            if (this == &other) {
+                return *this;
+            }
+
+            hash_map copy(other);
+
+            return *this = spark::move(copy);
+        }
+
+        hash_map& operator=(hash_map&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+
+            clear();
+
+            distances_ = spark::move(other.distances_);
+            entries_ = spark::move(other.entries_);
+            hasher_ = other.hasher_;
+            size_ = other.size_;
+            shift_ = other.shift_;
+
+            other.size_ = 0;
+
+            return *this;
+        }
+
+        // @brief constructs a value for a key that is not in the map yet
+        // @returns the value stored for the key, the existing one if the key was already present
+        template <typename... Args>
+        value_type& emplace(const key_type& key, Args&&... args) {
+            if (value_type* existing = find(key)) {
+                return *existing;
+            }
+
+            if (size_ + 1 > limit()) {
+                rehash(max(min_capacity, capacity() * 2));
+            }
+
+            value_type* placed = place(entry{key, value_type(spark::forward<Args>(args)...)});
+
+            return placed != nullptr ? *placed : *find(key);
+        }
+
+        // @brief provides the value stored for a key, default constructing it if the key is not in the map
+        value_type& operator[](const key_type& key) {
+            return emplace(key);
+        }
+
+        // @brief provides the value stored for a key
+        // @returns nullptr if the key is not in the map
+        [[nodiscard]] value_type* find(const key_type& key) {
+            size_type position = locate(key);
+
+            return position != npos ? &slot(position).value : nullptr;
+        }
+
+        [[nodiscard]] const value_type* find(const key_type& key) const {
+            size_type position = locate(key);
+
+            return position != npos ? &slot(position).value : nullptr;
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const {
+            return locate(key) != npos;
+        }
+
+        // @brief removes a key and its value
+        // @returns false if the key was not in the map
+        bool remove(const key_type& key) {
+            size_type position = locate(key);
+
+            if (position == npos) {
+                return false;
+            }
+
+            slot(position).~entry();
+
+            size_type mask = capacity() - 1;
+            size_type next = (position + 1) & mask;
+
+            while (distances_[next] > 1) {
+                new (static_cast<void*>(&entries_[position])) entry(spark::move(slot(next)));
+                slot(next).~entry();
+
+                distances_[position] = static_cast<uint8>(distances_[next] - 1);
+
+                position = next;
+                next = (next + 1) & mask;
+            }
+
+            distances_[position] = vacant;
+            size_--;
+
+            return true;
+        }
+
+        // @brief removes every key, keeping the allocated slots
+        void clear() {
+            for (size_type i = 0; i < distances_.size(); i++) {
+                if (distances_[i] != vacant) {
+                    slot(i).~entry();
+
+                    distances_[i] = vacant;
+                }
+            }
+
+            size_ = 0;
+        }
+
+        // @brief allocates slots for at least the provided number of keys, so inserting them does not rehash
+        void reserve(size_type count) {
+            size_type needed = min_capacity;
+
+            while (needed * max_load_numerator / max_load_denominator < count) {
+                needed *= 2;
+            }
+
+            if (needed > capacity()) {
+                rehash(needed);
+            }
+        }
+
+        // @brief invokes the callable for every key and value, in no particular order
+        // @param callable taking (const key, value)
+        template <typename F>
+        void each(F&& callable) {
+            for (size_type i = 0; i < distances_.size(); i++) {
+                if (distances_[i] != vacant) {
+                    entry& current = slot(i);
+
+                    callable(static_cast<const key_type&>(current.key), current.value);
+                }
+            }
+        }
+
+        template <typename F>
+        void each(F&& callable) const {
+            for (size_type i = 0; i < distances_.size(); i++) {
+                if (distances_[i] != vacant) {
+                    const entry& current = slot(i);
+
+                    callable(current.key, current.value);
+                }
+            }
+        }
+
+        // @brief gives the number of keys in the map
+        [[nodiscard]] size_type size() const {
+            return size_;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return size_ == 0;
+        }
+
+        // @brief gives the number of slots, a power of two
+        [[nodiscard]] size_type capacity() const {
+            return distances_.size();
+        }
+
+    private:
+        static constexpr size_type npos = static_cast<size_type>(-1);
+        static constexpr size_type min_capacity = 8;
+        static constexpr size_type max_load_numerator = 7;
+        static constexpr size_type max_load_denominator = 8;
+
+        // @note a slot stores its probe distance plus one, so 0 marks an empty slot
+        static constexpr uint8 vacant = 0;
+        static constexpr size_type max_distance = 255;
+
+        [[nodiscard]] entry& slot(size_type position) {
+            return *reinterpret_cast<entry*>(&entries_[position]);
+        }
+
+        [[nodiscard]] const entry& slot(size_type position) const {
+            return *reinterpret_cast<const entry*>(&entries_[position]);
+        }
+
+        [[nodiscard]] size_type limit() const {
+            return capacity() * max_load_numerator / max_load_denominator;
+        }
+
+        // @brief spreads a hash over the slots with a Fibonacci multiply, taking the top bits
+        [[nodiscard]] size_type home(const key_type& key) const {
+            return static_cast<size_type>((hasher_(key) * 0x9E3779B97F4A7C15) >> shift_);
+        }
+
+        [[nodiscard]] size_type locate(const key_type& key) const {
+            if (size_ == 0) {
+                return npos;
+            }
+
+            size_type mask = capacity() - 1;
+            size_type position = home(key);
+
+            for (size_type distance = 1; distances_[position] >= distance; distance++) {
+                if (distances_[position] == distance && slot(position).key == key) {
+                    return position;
+                }
+
+                position = (position + 1) & mask;
+            }
+
+            return npos;
+        }
+
+        // @brief inserts an entry whose key is not in the map, displacing entries closer to their home slot
+        // @returns the value of the inserted entry, or nullptr if the map had to grow on the way and moved it
+        value_type* place(entry&& inserted) {
+            entry carried = spark::move(inserted);
+
+            size_type mask = capacity() - 1;
+            size_type position = home(carried.key);
+            value_type* result = nullptr;
+
+            for (size_type distance = 1;; distance++) {
+                if (distance > max_distance) {
+                    // @note a probe sequence this long means a poor spread, so the carried entry goes in after growing
+                    // @note growing cannot help a hash that sends most keys to the same slots, which leaves the map mostly empty
+                    assert(size_ >= capacity() / 8 && "hash spreads keys too poorly for a byte of probe distance");
+
+                    rehash(capacity() * 2);
+                    place(spark::move(carried));
+
+                    return nullptr;
+                }
+
+                if (distances_[position] == vacant) {
+                    new (static_cast<void*>(&entries_[position])) entry(spark::move(carried));
+
+                    distances_[position] = static_cast<uint8>(distance);
+                    size_++;
+
+                    return result != nullptr ? result : &slot(position).value;
+                }
+
+                if (distances_[position] < distance) {
+                    entry& resident = slot(position);
+                    entry displaced = spark::move(resident);
+
+                    resident = spark::move(carried);
+                    carried = spark::move(displaced);
+
+                    size_type residentDistance = distances_[position];
+
+                    distances_[position] = static_cast<uint8>(distance);
+                    distance = residentDistance;
+
+                    if (result == nullptr) {
+                        result = &resident.value;
+                    }
+                }
+
+                position = (position + 1) & mask;
+            }
+        }
+
+        void rehash(size_type newCapacity) {
+            list<uint8, size_type> oldDistances = spark::move(distances_);
+            list<filler_of<entry>, size_type> oldEntries = spark::move(entries_);
+
+            distances_.resize(newCapacity, vacant);
+            entries_.resize(newCapacity);
+
+            shift_ = static_cast<size_type>(64 - std::countr_zero(static_cast<uint64>(newCapacity)));
+            size_ = 0;
+
+            for (size_type i = 0; i < oldDistances.size(); i++) {
+                if (oldDistances[i] != vacant) {
+                    entry& moved = *reinterpret_cast<entry*>(&oldEntries[i]);
+
+                    place(spark::move(moved));
+
+                    moved.~entry();
+                }
+            }
+        }
+
+        list<uint8, size_type> distances_;
+        list<filler_of<entry>, size_type> entries_;
+
+        [[no_unique_address]] hasher_type hasher_;
+
+        size_type size_ = 0;
+        size_type shift_ = 64;
+    };
+}
@@ -1,46 +1,66 @@
 #pragma once
 
+#include <spark/types/hash_map.hpp>
 #include <spark/types/list.hpp>
 
 namespace spark {
+    // @brief compile-time identifier of a type, a hash of the compiler's signature string for this function
+    // @note stable across translation units, but types sharing a name in different anonymous namespaces share an id
+    template <typename T>
+    [[nodiscard]] consteval uint64 type_hash() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        const char* name = __FUNCSIG__;
+#else
+        const char* name = __PRETTY_FUNCTION__;
+#endif
+
+        uint64 hash = 0xCBF29CE484222325;
+
+        for (uint64 i = 0; name[i] != '\0'; i++) {
+            hash ^= static_cast<uint8>(name[i]);
+            hash *= 0x100000001B3;
+        }
+
+        return hash;
+    }
+
+    // @brief maps types to dense indices local to its owner
+    // @note the compile-time hash of a type is remapped once, later lookups probe a hash_map whose home slot folds to a constant shift
     template <typename T = uint64>
     requires(is_unsigned<T>)
     class type_indexer {
     public:
         using size_type = T;
 
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
         template <typename U>
         size_type index() {
-            size_type globalID = type_indexer::globalIndex<U>();
+            constexpr uint64 id = type_hash<U>();
 
-            if (globalID >= typeMap_.size()) {
-                typeMap_.resize(globalID + 1, size_type(-1));
+            if (const size_type* found = typeMap_.find(id)) {
+                return *found;
             }
 
-            if (typeMap_[globalID] == size_type(-1)) {
-                typeMap_[globalID] = counter_++;
-            }
+            return typeMap_.emplace(id, typeMap_.size());
+        }
 
-            return typeMap_[globalID];
+        // @brief gives the index of a type without assigning one
+        // @returns npos if the type has not been indexed yet
+        template <typename U>
+        [[nodiscard]] size_type find() const {
+            constexpr uint64 id = type_hash<U>();
+
+            const size_type* found = typeMap_.find(id);
+
+            return found != nullptr ? *found : npos;
         }
 
         void reset() {
             typeMap_.clear();
-            counter_ = 0;
         }
 
     private:
-        template <typename>
-        static size_type globalIndex() {
-            static size_type id = static_cast<size_type>(globalCounter_++);
-
-            return id;
-        }
-
-        spark::list<size_type> typeMap_;
-
-        size_type counter_ = 0;
-
-        inline static uint64 globalCounter_ = 0;
+        hash_map<uint64, size_type, hasher<uint64>, size_type> typeMap_;
     };
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstring>
 #include <new>
 
+#include <spark/types/allocator.hpp>
 #include <spark/types/core.hpp>
 #include <spark/types/span.hpp>
 
@@ -21,49 +23,56 @@ namespace spark {
 
     // @brief a dynamically sized contiguous list of elements
     // @note operates on a FILO basis (first in = last out)
-    template <typename T, typename U = uint64, typename V = double_growth_policy>
+    // @note memory comes from the allocator, see allocator.hpp for the arena, monotonic and pool allocators
+    // @note copying or moving a list, by construction or assignment, takes the allocator of the source
+    template <typename T, typename U = uint64, typename V = double_growth_policy, typename A = heap_allocator>
     requires(is_unsigned<U>)
     class list {
     public:
         using size_type = U;
         using type = T;
         using growth_policy = V;
+        using allocator_type = A;
 
         inline constexpr list() noexcept = default;
 
+        inline constexpr explicit list(const allocator_type& allocator) noexcept
+            : allocator_(allocator) {
+        }
+
         inline constexpr ~list() noexcept {
             clear();
         }
 
+        // @note never chosen over the copy, move and allocator constructors
         template <typename... Args>
+        requires(!(sizeof...(Args) == 1 && ((is_same<remove_const<remove_reference<Args>>, list> || is_same<remove_const<remove_reference<Args>>, allocator_type>) && ...)))
         inline constexpr list(Args&&... args) noexcept
             : size_(sizeof...(Args)), capacity_(sizeof...(Args)) {
             if (capacity_ == 0) {
                 return;
             }
 
-            data_ = static_cast<type*>(operator new(sizeof(type) * capacity_));
+            data_ = allocate(capacity_);
 
             size_type i = 0;
 
-            ((new (&data_[i++]) type(forward<Args>(args))), ...);
+            ((new (&data_[i++]) type(spark::forward<Args>(args))), ...);
         }
 
         inline constexpr list(const list& other)
-            : size_(other.size_), capacity_(other.capacity_) {
+            : size_(other.size_), capacity_(other.capacity_), allocator_(other.allocator_) {
             if (capacity_ == 0) {
                 return;
             }
 
-            data_ = static_cast<type*>(operator new(sizeof(type) * capacity_));
+            data_ = allocate(capacity_);
 
-            for (size_type i = 0; i < size_; i++) {
-                new (&data_[i]) type(other.data_[i]);
-            }
+            copy(data_, other.data_, size_);
         }
 
         inline constexpr list(list&& other) noexcept
-            : size_(other.size_), capacity_(other.capacity_), data_(other.data_) {
+            : size_(other.size_), capacity_(other.capacity_), data_(other.data_), allocator_(other.allocator_) {
             other.data_ = nullptr;
             other.size_ = 0;
             other.capacity_ = 0;
@@ -78,13 +87,12 @@ namespace spark {
 
             size_ = other.size_;
             capacity_ = other.capacity_;
+            allocator_ = other.allocator_;
 
             if (capacity_ > 0) {
-                data_ = static_cast<type*>(operator new(sizeof(type) * capacity_));
+                data_ = allocate(capacity_);
 
-                for (size_type i = 0; i < size_; i++) {
-                    new (&data_[i]) type(other.data_[i]);
-                }
+                copy(data_, other.data_, size_);
             }
 
             return *this;
@@ -100,6 +108,7 @@ namespace spark {
             size_ = other.size_;
             capacity_ = other.capacity_;
             data_ = other.data_;
+            allocator_ = other.allocator_;
 
             other.data_ = nullptr;
             other.size_ = 0;
@@ -133,11 +142,9 @@ namespace spark {
         // @brief erases and resets the entire list
         inline constexpr void clear() noexcept {
             if (data_ != nullptr) {
-                for (size_type i = 0; i < size_; i++) {
-                    data_[i].~type();
-                }
+                destroy(0, size_);
 
-                operator delete(data_);
+                deallocate(data_, capacity_);
 
                 data_ = nullptr;
             }
@@ -153,7 +160,7 @@ namespace spark {
                 reserve(growth_policy::expand(capacity_));
             }
 
-            new (&data_[size_]) type(forward<T>(value));
+            new (&data_[size_]) type(spark::forward<T>(value));
 
             return data_[size_++];
         }
@@ -167,7 +174,7 @@ namespace spark {
                 reserve(growth_policy::expand(capacity_));
             }
 
-            new (static_cast<void*>(&data_[size_])) type(forward<Args>(args)...);
+            new (static_cast<void*>(&data_[size_])) type(spark::forward<Args>(args)...);
 
             return data_[size_++];
         }
@@ -178,9 +185,9 @@ namespace spark {
                 return;
             }
 
-            type temporary = data_[a];
-            data_[a] = data_[b];
-            data_[b] = temporary;
+            type temporary = spark::move(data_[a]);
+            data_[a] = spark::move(data_[b]);
+            data_[b] = spark::move(temporary);
         }
 
         // @brief removes the end element from the list
@@ -193,19 +200,25 @@ namespace spark {
         // @brief allocates additional space in the list
         // @param new capacity
         // @note will only reallocate if new capacity > current capacity
+        // @note trivially relocatable elements are grown in place when the allocator can expand, and copied byte for byte otherwise
         inline constexpr void reserve(size_type newCapacity) noexcept {
             if (newCapacity <= capacity_) {
                 return;
             }
 
-            type* newData = static_cast<type*>(operator new(sizeof(type) * newCapacity));
+            if constexpr (is_trivially_relocatable<type> && requires { allocator_.expand(data_, capacity_, newCapacity); }) {
+                if (data_ != nullptr && allocator_.expand(data_, sizeof(type) * capacity_, sizeof(type) * newCapacity)) {
+                    capacity_ = newCapacity;
 
-            for (size_type i = 0; i < size_; i++) {
-                new (static_cast<void*>(&newData[i])) type(move(data_[i]));
-                data_[i].~type();
+                    return;
+                }
             }
 
-            operator delete(data_);
+            type* newData = allocate(newCapacity);
+
+            relocate(newData, data_, size_);
+
+            deallocate(data_, capacity_);
 
             data_ = newData;
             capacity_ = newCapacity;
@@ -222,15 +235,25 @@ namespace spark {
             }
 
             if (newSize > capacity_) {
-                reserve(newSize);
+                reserve(max(newSize, growth_policy::expand(capacity_)));
             }
 
             for (size_type i = size_; i < newSize; i++) {
                 new (static_cast<void*>(&data_[i])) type;
             }
 
-            for (size_type i = newSize; i < size_; i++) {
-                data_[i].~type();
+            destroy(newSize, size_);
+
+            size_ = newSize;
+        }
+
+        // @brief resizes the list to the provided size, leaving new elements uninitialized
+        // @param new size
+        // @note meant for lists about to be overwritten in bulk, such as memcpy targets
+        inline constexpr void resize_uninitialized(size_type newSize) noexcept
+        requires(is_trivially_copyable<T>) {
+            if (newSize > capacity_) {
+                reserve(max(newSize, growth_policy::expand(capacity_)));
             }
 
             size_ = newSize;
@@ -247,16 +270,14 @@ namespace spark {
             }
 
             if (newSize > capacity_) {
-                reserve(newSize);
+                reserve(max(newSize, growth_policy::expand(capacity_)));
             }
 
             for (size_type i = size_; i < newSize; i++) {
                 new (&data_[i]) type(value);
             }
 
-            for (size_type i = newSize; i < size_; i++) {
-                data_[i].~type();
-            }
+            destroy(newSize, size_);
 
             size_ = newSize;
         }
@@ -273,15 +294,11 @@ namespace spark {
                 return;
             }
 
-            type* newData = static_cast<type*>(operator new(sizeof(type) * size_));
-
-            for (size_type i = 0; i < size_; i++) {
-                new (static_cast<void*>(&newData[i])) type(move(data_[i]));
+            type* newData = allocate(size_);
 
-                data_[i].~type();
-            }
+            relocate(newData, data_, size_);
 
-            operator delete(data_);
+            deallocate(data_, capacity_);
 
             data_ = newData;
             capacity_ = size_;
@@ -362,9 +379,69 @@ namespace spark {
             return data_ + size_;
         }
 
+        // @brief provides the allocator the list takes its memory from
+        [[nodiscard]] inline constexpr const allocator_type& allocator() const noexcept {
+            return allocator_;
+        }
+
     private:
+        inline constexpr type* allocate(size_type count) {
+            return static_cast<type*>(allocate_or_abort(allocator_, sizeof(type) * count, alignof(type)));
+        }
+
+        inline constexpr void deallocate(type* memory, size_type count) noexcept {
+            if (memory != nullptr) {
+                allocator_.deallocate(memory, sizeof(type) * count, alignof(type));
+            }
+        }
+
+        // @brief copy constructs elements into uninitialized memory
+        inline constexpr static void copy(type* destination, const type* source, size_type count) {
+            if constexpr (is_trivially_copyable<type>) {
+                if (count > 0) {
+                    std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(type) * count);
+                }
+            }
+            else {
+                for (size_type i = 0; i < count; i++) {
+                    new (static_cast<void*>(&destination[i])) type(source[i]);
+                }
+            }
+        }
+
+        // @brief moves elements into uninitialized memory, the source is left to be released without destruction
+        inline constexpr static void relocate(type* destination, type* source, size_type count) noexcept {
+            if constexpr (is_trivially_relocatable<type>) {
+                if (count > 0) {
+                    std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(type) * count);
+                }
+            }
+            else {
+                for (size_type i = 0; i < count; i++) {
+                    new (static_cast<void*>(&destination[i])) type(spark::move(source[i]));
+
+                    source[i].~type();
+                }
+            }
+        }
+
+        // @brief destroys the elements in [from, to)
+        inline constexpr void destroy(size_type from, size_type to) noexcept {
+            if constexpr (!is_trivially_destructible<type>) {
+                for (size_type i = from; i < to; i++) {
+                    data_[i].~type();
+                }
+            }
+        }
+
         size_type size_ = 0;
         size_type capacity_ = 0;
         type* data_ = nullptr;
+
+        [[no_unique_address]] allocator_type allocator_;
     };
+
+    // @note a list only points at its elements, so it can be moved byte for byte
+    template <typename T, typename U, typename V, typename A>
+    inline constexpr bool is_trivially_relocatable<list<T, U, V, A>> = true;
 }
\ No newline at end of file
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <bit>
+#include <cstring>
+#include <new>
+
+#include <spark/types/allocator.hpp>
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/values.hpp>
+
+namespace spark {
+    // @brief a list split into fixed-size blocks, so elements never move once added
+    // @note B elements per block, a power of two, so an index splits into block and offset with a shift and a mask
+    // @note growing only allocates a new block, references stay valid until their element is popped
+    // @note shrinking frees trailing blocks, keeping a single spare one past the last element
+    // @note copying or moving a segmented_list, by construction or assignment, takes the allocator of the source
+    template <typename T, typename U = uint64, uint64 B = 1024, typename A = heap_allocator>
+    requires(is_unsigned<U> && B > 0 && (B & (B - 1)) == 0)
+    class segmented_list {
+    public:
+        using size_type = U;
+        using type = T;
+        using allocator_type = A;
+
+        static constexpr size_type block_size = static_cast<size_type>(B);
+
+        template <bool C>
+        class basic_iterator {
+        public:
+            using owner_type = conditional<C, const segmented_list, segmented_list>;
+            using reference = conditional<C, const type&, type&>;
+
+            basic_iterator(owner_type* owner, size_type index)
+                : owner_(owner), index_(index) {
+            }
+
+            [[nodiscard]] reference operator*() const {
+                return (*owner_)[index_];
+            }
+
+            basic_iterator& operator++() {
+                index_++;
+
+                return *this;
+            }
+
+            [[nodiscard]] bool operator==(const basic_iterator& other) const {
+                return index_ == other.index_;
+            }
+
+        private:
+            owner_type* owner_;
+            size_type index_;
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        segmented_list() = default;
+
+        explicit segmented_list(const allocator_type& allocator)
+            : allocator_(allocator) {
+        }
+
+        ~segmented_list() {
+            clear();
+        }
+
+        segmented_list(const segmented_list& other)
+            : allocator_(other.allocator_) {
+            reserve(other.size_);
+
+            for (size_type i = 0; i < other.size_; i++) {
+                new (static_cast<void*>(&(*this)[i])) type(other[i]);
+            }
+
+            size_ = other.size_;
+        }
+
+        segmented_list(segmented_list&& other) noexcept
+            : blocks_(spark::move(other.blocks_)), size_(other.size_), allocator_(other.allocator_) {
+            other.size_ = 0;
+        }
+
+        segmented_list& operator=(const segmented_list& other) {
+            if (this == &other) {
+                return *this;
+            }
+
+            clear();
+
+            allocator_ = other.allocator_;
+
+            reserve(other.size_);
+
+            for (size_type i = 0; i < other.size_; i++) {
+                new (static_cast<void*>(&(*this)[i])) type(other[i]);
+            }
+
+            size_ = other.size_;
+
+            return *this;
+        }
+
+        segmented_list& operator=(segmented_list&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+
+            clear();
+
+            blocks_ = spark::move(other.blocks_);
+            size_ = other.size_;
+            allocator_ = other.allocator_;
+
+            other.size_ = 0;
+
+            return *this;
+        }
+
+        [[nodiscard]] type& operator[](size_type index) noexcept {
+            return blocks_[index >> shift][index & mask];
+        }
+
+        [[nodiscard]] const type& operator[](size_type index) const noexcept {
+            return blocks_[index >> shift][index & mask];
+        }
+
+        // @brief destroys every element and frees every block
+        void clear() noexcept {
+            destroy(0, size_);
+
+            for (type* block : blocks_) {
+                allocator_.deallocate(block, sizeof(type) * block_size, alignof(type));
+            }
+
+            blocks_.clear();
+            size_ = 0;
+        }
+
+        // @brief appends a new element to the list
+        // @param the new element
+        // @returns reference to the new element
+        type& push(T&& value) noexcept {
+            return emplace(spark::forward<T>(value));
+        }
+
+        // @brief constructs and appends a new element to the list
+        // @param arguments for construction of the element
+        // @returns reference to the new element
+        template <typename... Args>
+        type& emplace(Args&&... args) noexcept {
+            if (size_ == capacity()) {
+                grow();
+            }
+
+            type* slot = &(*this)[size_++];
+
+            new (static_cast<void*>(slot)) type(spark::forward<Args>(args)...);
+
+            return *slot;
+        }
+
+        // @brief swaps the elements at the provided locations
+        void swap(size_type a, size_type b) noexcept {
+            if (a == b) {
+                return;
+            }
+
+            type temporary = spark::move((*this)[a]);
+            (*this)[a] = spark::move((*this)[b]);
+            (*this)[b] = spark::move(temporary);
+        }
+
+        // @brief removes the end element from the list
+        void pop() noexcept {
+            if (size_ > 0) {
+                (*this)[--size_].~type();
+
+                release();
+            }
+        }
+
+        // @brief allocates blocks for at least the provided number of elements
+        void reserve(size_type newCapacity) noexcept {
+            while (capacity() < newCapacity) {
+                grow();
+            }
+        }
+
+        // @brief resizes the list to the provided size
+        // @param new size
+        // @note new elements will be default constructed if new size > current size
+        void resize(size_type newSize) noexcept {
+            reserve(newSize);
+
+            for (size_type i = size_; i < newSize; i++) {
+                new (static_cast<void*>(&(*this)[i])) type;
+            }
+
+            shrink(newSize);
+        }
+
+        // @brief resizes the list to the provided size
+        // @param new size
+        // @param value to use for new elements
+        void resize(size_type newSize, const type& value) noexcept {
+            reserve(newSize);
+
+            for (size_type i = size_; i < newSize; i++) {
+                new (static_cast<void*>(&(*this)[i])) type(value);
+            }
+
+            shrink(newSize);
+        }
+
+        // @brief frees every block past the last element, the spare one included
+        void trim() noexcept {
+            size_type used = (size_ + mask) >> shift;
+
+            while (blocks_.size() > used) {
+                allocator_.deallocate(blocks_.last(), sizeof(type) * block_size, alignof(type));
+                blocks_.pop();
+            }
+
+            blocks_.trim();
+        }
+
+        // @brief copies every element into contiguous memory
+        void copy_to(type* destination) const noexcept
+        requires(is_trivially_copyable<T>) {
+            for (size_type offset = 0; offset < size_; offset += block_size) {
+                size_type count = min(block_size, size_ - offset);
+
+                std::memcpy(static_cast<void*>(destination + offset), blocks_[offset >> shift], sizeof(type) * count);
+            }
+        }
+
+        // @brief overwrites every element from contiguous memory
+        void copy_from(const type* source) noexcept
+        requires(is_trivially_copyable<T>) {
+            for (size_type offset = 0; offset < size_; offset += block_size) {
+                size_type count = min(block_size, size_ - offset);
+
+                std::memcpy(static_cast<void*>(blocks_[offset >> shift]), source + offset, sizeof(type) * count);
+            }
+        }
+
+        // @brief gives the size of the list
+        [[nodiscard]] size_type size() const noexcept {
+            return size_;
+        }
+
+        // @brief gives the number of elements the allocated blocks can hold
+        [[nodiscard]] size_type capacity() const noexcept {
+            return blocks_.size() * block_size;
+        }
+
+        // @brief checks if the list is empty
+        [[nodiscard]] bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        // @brief provides the first element in the list
+        [[nodiscard]] type& first() noexcept {
+            return (*this)[0];
+        }
+
+        // @brief provides the last element in the list
+        [[nodiscard]] type& last() noexcept {
+            return (*this)[size_ - 1];
+        }
+
+        // @brief provides the first element in the list
+        [[nodiscard]] const type& first() const noexcept {
+            return (*this)[0];
+        }
+
+        // @brief provides the last element in the list
+        [[nodiscard]] const type& last() const noexcept {
+            return (*this)[size_ - 1];
+        }
+
+        iterator begin() noexcept {
+            return iterator(this, 0);
+        }
+
+        iterator end() noexcept {
+            return iterator(this, size_);
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(this, size_);
+        }
+
+        // @brief provides the allocator blocks are taken from
+        [[nodiscard]] const allocator_type& allocator() const noexcept {
+            return allocator_;
+        }
+
+    private:
+        static constexpr size_type mask = block_size - 1;
+        static constexpr size_type shift = static_cast<size_type>(std::countr_zero(B));
+
+        void grow() {
+            blocks_.emplace(static_cast<type*>(allocate_or_abort(allocator_, sizeof(type) * block_size, alignof(type))));
+        }
+
+        // @brief destroys the elements past the new size and frees the blocks left unused
+        void shrink(size_type newSize) noexcept {
+            destroy(newSize, size_);
+
+            size_ = newSize;
+
+            release();
+        }
+
+        // @brief frees trailing blocks, keeping one spare block so popping and pushing across a boundary does not thrash
+        void release() noexcept {
+            size_type kept = ((size_ + mask) >> shift) + 1;
+
+            while (blocks_.size() > kept) {
+                allocator_.deallocate(blocks_.last(), sizeof(type) * block_size, alignof(type));
+                blocks_.pop();
+            }
+        }
+
+        // @brief destroys the elements in [from, to)
+        void destroy(size_type from, size_type to) noexcept {
+            if constexpr (!is_trivially_destructible<type>) {
+                for (size_type i = from; i < to; i++) {
+                    (*this)[i].~type();
+                }
+            }
+        }
+
+        list<type*, size_type> blocks_;
+        size_type size_ = 0;
+
+        [[no_unique_address]] allocator_type allocator_;
+    };
+
+    // @note blocks are owned through pointers, so the list itself moves byte for byte
+    template <typename T, typename U, uint64 B, typename A>
+    inline constexpr bool is_trivially_relocatable<segmented_list<T, U, B, A>> = true;
+}
@@ -0,0 +1,430 @@
+#pragma once
+
+#include <cstring>
+#include <new>
+
+#include <spark/types/allocator.hpp>
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/span.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/values.hpp>
+
+namespace spark {
+    // @brief a list that keeps up to N elements inside itself and only allocates past that
+    // @note shares the list API, elements live inline while capacity() == N
+    // @note holds no pointer to itself, so it is trivially relocatable whenever its elements are
+    // @note copying or moving a small_list, by construction or assignment, takes the allocator of the source
+    template <typename T, uint64 N, typename U = uint64, typename V = double_growth_policy, typename A = heap_allocator>
+    requires(is_unsigned<U> && N > 0)
+    class small_list {
+    public:
+        using size_type = U;
+        using type = T;
+        using growth_policy = V;
+        using allocator_type = A;
+
+        static constexpr size_type inline_capacity = static_cast<size_type>(N);
+
+        inline constexpr small_list() noexcept = default;
+
+        inline constexpr explicit small_list(const allocator_type& allocator) noexcept
+            : allocator_(allocator) {
+        }
+
+        inline constexpr ~small_list() noexcept {
+            clear();
+        }
+
+        // @note never chosen over the copy, move and allocator constructors
+        template <typename... Args>
+        requires(!(sizeof...(Args) == 1 && ((is_same<remove_const<remove_reference<Args>>, small_list> || is_same<remove_const<remove_reference<Args>>, allocator_type>) && ...)))
+        inline constexpr small_list(Args&&... args) noexcept {
+            reserve(static_cast<size_type>(sizeof...(Args)));
+
+            ((new (static_cast<void*>(&data()[size_++])) type(spark::forward<Args>(args))), ...);
+        }
+
+        inline constexpr small_list(const small_list& other)
+            : allocator_(other.allocator_) {
+            reserve(other.size_);
+
+            copy(data(), other.data(), other.size_);
+
+            size_ = other.size_;
+        }
+
+        inline constexpr small_list(small_list&& other) noexcept
+            : allocator_(other.allocator_) {
+            take(other);
+        }
+
+        inline constexpr small_list& operator=(const small_list& other) {
+            if (this == &other) {
+                return *this;
+            }
+
+            clear();
+
+            allocator_ = other.allocator_;
+
+            reserve(other.size_);
+
+            copy(data(), other.data(), other.size_);
+
+            size_ = other.size_;
+
+            return *this;
+        }
+
+        inline constexpr small_list& operator=(small_list&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+
+            clear();
+
+            allocator_ = other.allocator_;
+
+            take(other);
+
+            return *this;
+        }
+
+        [[nodiscard]] inline constexpr type& operator[](size_type index) noexcept {
+            return data()[index];
+        }
+
+        [[nodiscard]] inline constexpr const type& operator[](size_type index) const noexcept {
+            return data()[index];
+        }
+
+        inline constexpr operator span<T>() noexcept {
+            return span<T>(data(), size_);
+        }
+
+        inline constexpr operator span<const T>() const noexcept {
+            return span<const T>(data(), size_);
+        }
+
+        // @brief sorts elements with a provided algorithm and condition
+        template <typename S, typename C>
+        inline constexpr void sort() noexcept {
+            S::template sort<T, C>(data(), size_);
+        }
+
+        // @brief erases every element and returns to the inline storage
+        inline constexpr void clear() noexcept {
+            destroy(0, size_);
+
+            if (!isInline()) {
+                allocator_.deallocate(heap_, sizeof(type) * capacity_, alignof(type));
+            }
+
+            size_ = 0;
+            capacity_ = inline_capacity;
+        }
+
+        // @brief appends a new element to the list
+        // @param the new element
+        // @returns reference to the new element
+        inline constexpr type& push(T&& value) noexcept {
+            if (size_ >= capacity_) {
+                reserve(growth_policy::expand(capacity_));
+            }
+
+            new (static_cast<void*>(&data()[size_])) type(spark::forward<T>(value));
+
+            return data()[size_++];
+        }
+
+        // @brief constructs and appends a new element to the list
+        // @param arguments for construction of the element
+        // @returns reference to the new element
+        template <typename... Args>
+        inline constexpr type& emplace(Args&&... args) noexcept {
+            if (size_ >= capacity_) {
+                reserve(growth_policy::expand(capacity_));
+            }
+
+            new (static_cast<void*>(&data()[size_])) type(spark::forward<Args>(args)...);
+
+            return data()[size_++];
+        }
+
+        // @brief swaps the elements at the provided locations
+        inline constexpr void swap(size_type a, size_type b) noexcept {
+            if (a == b) {
+                return;
+            }
+
+            type* elements = data();
+
+            type temporary = spark::move(elements[a]);
+            elements[a] = spark::move(elements[b]);
+            elements[b] = spark::move(temporary);
+        }
+
+        // @brief removes the end element from the list
+        inline constexpr void pop() noexcept {
+            if (size_ > 0) {
+                data()[--size_].~type();
+            }
+        }
+
+        // @brief moves the elements to the heap once they outgrow the inline storage
+        // @param new capacity
+        // @note will only reallocate if new capacity > current capacity
+        inline constexpr void reserve(size_type newCapacity) noexcept {
+            if (newCapacity <= capacity_) {
+                return;
+            }
+
+            auto* newData = static_cast<type*>(allocate_or_abort(allocator_, sizeof(type) * newCapacity, alignof(type)));
+
+            relocate(newData, data(), size_);
+
+            if (!isInline()) {
+                allocator_.deallocate(heap_, sizeof(type) * capacity_, alignof(type));
+            }
+
+            heap_ = newData;
+            capacity_ = newCapacity;
+        }
+
+        // @brief resizes the list to the provided size
+        // @param new size
+        // @note new elements will be default constructed if new size > current size
+        inline constexpr void resize(size_type newSize) noexcept {
+            if (newSize > capacity_) {
+                reserve(max(newSize, growth_policy::expand(capacity_)));
+            }
+
+            for (size_type i = size_; i < newSize; i++) {
+                new (static_cast<void*>(&data()[i])) type;
+            }
+
+            destroy(newSize, size_);
+
+            size_ = newSize;
+        }
+
+        // @brief resizes the list to the provided size
+        // @param new size
+        // @param value to use for new elements
+        inline constexpr void resize(size_type newSize, const type& value) noexcept {
+            if (newSize > capacity_) {
+                reserve(max(newSize, growth_policy::expand(capacity_)));
+            }
+
+            for (size_type i = size_; i < newSize; i++) {
+                new (static_cast<void*>(&data()[i])) type(value);
+            }
+
+            destroy(newSize, size_);
+
+            size_ = newSize;
+        }
+
+        // @brief resizes the list to the provided size, leaving new elements uninitialized
+        // @param new size
+        inline constexpr void resize_uninitialized(size_type newSize) noexcept
+        requires(is_trivially_copyable<T>) {
+            if (newSize > capacity_) {
+                reserve(max(newSize, growth_policy::expand(capacity_)));
+            }
+
+            size_ = newSize;
+        }
+
+        // @brief frees all unused space
+        // @note moves the elements back inline if they fit
+        inline constexpr void trim() noexcept {
+            if (isInline() || size_ == capacity_) {
+                return;
+            }
+
+            type* oldData = heap_;
+            size_type oldCapacity = capacity_;
+
+            if (size_ <= inline_capacity) {
+                capacity_ = inline_capacity;
+
+                relocate(inlineData(), oldData, size_);
+            }
+            else {
+                heap_ = static_cast<type*>(allocate_or_abort(allocator_, sizeof(type) * size_, alignof(type)));
+                capacity_ = size_;
+
+                relocate(heap_, oldData, size_);
+            }
+
+            allocator_.deallocate(oldData, sizeof(type) * oldCapacity, alignof(type));
+        }
+
+        // @brief gives the size of the list
+        [[nodiscard]] inline constexpr size_type size() const noexcept {
+            return size_;
+        }
+
+        // @brief gives the current allocation size of the list, N while the elements are inline
+        [[nodiscard]] inline constexpr size_type capacity() const noexcept {
+            return capacity_;
+        }
+
+        // @brief checks if the list is empty
+        [[nodiscard]] inline constexpr bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        // @brief provides access to the raw memory pointer
+        [[nodiscard]] inline constexpr type* data() noexcept {
+            return isInline() ? inlineData() : heap_;
+        }
+
+        // @brief provides access to the raw memory pointer
+        [[nodiscard]] inline constexpr const type* data() const noexcept {
+            return isInline() ? inlineData() : heap_;
+        }
+
+        // @brief provides a span over a region of this list
+        // @param the offset into this list to start from
+        // @param the size of the product span
+        [[nodiscard]] inline constexpr span<T> sublist(size_type offset, size_type size) noexcept {
+            return span<T>(data() + offset, size);
+        }
+
+        // @brief provides a span over a region of this list
+        // @param the offset into this list to start from
+        // @param the size of the product span
+        [[nodiscard]] inline constexpr span<const T> sublist(size_type offset, size_type size) const noexcept {
+            return span<const T>(data() + offset, size);
+        }
+
+        // @brief provides the first element in the list
+        [[nodiscard]] inline constexpr type& first() noexcept {
+            return *data();
+        }
+
+        // @brief provides the last element in the list
+        [[nodiscard]] inline constexpr type& last() noexcept {
+            return data()[size_ - 1];
+        }
+
+        // @brief provides the first element in the list
+        [[nodiscard]] inline constexpr const type& first() const noexcept {
+            return *data();
+        }
+
+        // @brief provides the last element in the list
+        [[nodiscard]] inline constexpr const type& last() const noexcept {
+            return data()[size_ - 1];
+        }
+
+        inline constexpr type* begin() noexcept {
+            return data();
+        }
+
+        inline constexpr type* end() noexcept {
+            return data() + size_;
+        }
+
+        inline constexpr const type* begin() const noexcept {
+            return data();
+        }
+
+        inline constexpr const type* end() const noexcept {
+            return data() + size_;
+        }
+
+        // @brief provides the allocator the list spills to
+        [[nodiscard]] inline constexpr const allocator_type& allocator() const noexcept {
+            return allocator_;
+        }
+
+    private:
+        [[nodiscard]] inline constexpr bool isInline() const noexcept {
+            return capacity_ == inline_capacity;
+        }
+
+        [[nodiscard]] inline constexpr type* inlineData() noexcept {
+            return reinterpret_cast<type*>(buffer_);
+        }
+
+        [[nodiscard]] inline constexpr const type* inlineData() const noexcept {
+            return reinterpret_cast<const type*>(buffer_);
+        }
+
+        // @brief takes the elements of another list, leaving it empty and inline
+        inline constexpr void take(small_list& other) noexcept {
+            if (other.isInline()) {
+                relocate(inlineData(), other.inlineData(), other.size_);
+            }
+            else {
+                heap_ = other.heap_;
+            }
+
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+
+            other.size_ = 0;
+            other.capacity_ = inline_capacity;
+        }
+
+        // @brief copy constructs elements into uninitialized memory
+        inline constexpr static void copy(type* destination, const type* source, size_type count) {
+            if constexpr (is_trivially_copyable<type>) {
+                if (count > 0) {
+                    std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(type) * count);
+                }
+            }
+            else {
+                for (size_type i = 0; i < count; i++) {
+                    new (static_cast<void*>(&destination[i])) type(source[i]);
+                }
+            }
+        }
+
+        // @brief moves elements into uninitialized memory, the source is left to be released without destruction
+        inline constexpr static void relocate(type* destination, type* source, size_type count) noexcept {
+            if constexpr (is_trivially_relocatable<type>) {
+                if (count > 0) {
+                    std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(type) * count);
+                }
+            }
+            else {
+                for (size_type i = 0; i < count; i++) {
+                    new (static_cast<void*>(&destination[i])) type(spark::move(source[i]));
+
+                    source[i].~type();
+                }
+            }
+        }
+
+        // @brief destroys the elements in [from, to)
+        inline constexpr void destroy(size_type from, size_type to) noexcept {
+            if constexpr (!is_trivially_destructible<type>) {
+                type* elements = data();
+
+                for (size_type i = from; i < to; i++) {
+                    elements[i].~type();
+                }
+            }
+        }
+
+        size_type size_ = 0;
+        size_type capacity_ = inline_capacity;
+
+        union {
+            type* heap_;
+            alignas(type) uint8 buffer_[sizeof(type) * N];
+        };
+
+        [[no_unique_address]] allocator_type allocator_;
+    };
+
+    // @note a small list holds no pointer to itself, so it moves byte for byte whenever its elements do
+    template <typename T, uint64 N, typename U, typename V, typename A>
+    inline constexpr bool is_trivially_relocatable<small_list<T, N, U, V, A>> = is_trivially_relocatable<T>;
+}
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <cstring>
+#include <new>
+
+#include <spark/types/core.hpp>
+#include <spark/types/list.hpp>
+#include <spark/types/span.hpp>
+#include <spark/types/sparse_set.hpp>
+#include <spark/types/traits.hpp>
+
+#include <spark/utilities/values.hpp>
+
+namespace spark {
+    // @brief names the data members a type is split into, in declaration order, see soa_set
+    template <auto... Ms>
+    struct soa_fields {};
+
+    // @brief gives the size of a struct holding exactly the provided members, in order, padding included
+    template <auto... Ms>
+    inline constexpr uint64 soa_fields_size = [] {
+        uint64 size = 0;
+        uint64 alignment = 1;
+
+        ((size = (size + alignof(member_type<Ms>) - 1) / alignof(member_type<Ms>) * alignof(member_type<Ms>) + sizeof(member_type<Ms>),
+          alignment = alignof(member_type<Ms>) > alignment ? alignof(member_type<Ms>) : alignment), ...);
+
+        return (size + alignment - 1) / alignment * alignment;
+    }();
+
+    // @brief maps sparse indices to elements stored as one array per data member
+    // @note F is a soa_fields naming every data member of T in declaration order, checked by rebuilding the size of T from the fields
+    // @note every column starts on a column_alignment boundary, so loops over a single member vectorise cleanly
+    // @note elements are gathered into a copy when read and scattered when written, there is no reference to a whole element
+    template <typename T, typename F, typename U = uint64>
+    requires(is_unsigned<U>)
+    class soa_set;
+
+    template <typename T, auto... Ms, typename U>
+    requires(is_unsigned<U>)
+    class soa_set<T, soa_fields<Ms...>, U> {
+    public:
+        using type = T;
+        using size_type = U;
+
+        static constexpr size_type dead_index = static_cast<size_type>(-1);
+        static constexpr uint64 column_alignment = 64;
+        static constexpr uint64 field_count = sizeof...(Ms);
+        static constexpr bool stores_elements = true;
+        static constexpr bool stores_ticks = false;
+
+        static_assert(field_count > 0, "soa_set needs at least one field");
+        static_assert((is_same<member_owner<Ms>, type> && ...), "soa_set fields must be data members of the stored type");
+        static_assert(is_trivially_copyable<type>, "soa_set elements are moved byte for byte");
+        static_assert(soa_fields_size<Ms...> == sizeof(type), "soa_set fields must name every data member of the stored type, in declaration order");
+        static_assert(((alignof(member_type<Ms>) <= column_alignment) && ...), "soa_set fields are over-aligned");
+
+        soa_set() = default;
+
+        ~soa_set() {
+            release();
+        }
+
+        soa_set(const soa_set& other)
+            : slots_(other.slots_) {
+            copyColumns(other);
+        }
+
+        soa_set(soa_set&& other) noexcept
+            : slots_(spark::move(other.slots_)), columns_(spark::move(other.columns_)), capacity_(other.capacity_) {
+            other.capacity_ = 0;
+        }
+
+        soa_set& operator=(const soa_set& other) {
+            if (this == &other) {
+                return *this;
+            }
+
+            release();
+
+            slots_ = other.slots_;
+            copyColumns(other);
+
+            return *this;
+        }
+
+        soa_set& operator=(soa_set&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+
+            release();
+
+            slots_ = spark::move(other.slots_);
+            columns_ = spark::move(other.columns_);
+            capacity_ = other.capacity_;
+
+            other.capacity_ = 0;
+
+            return *this;
+        }
+
+        // @brief constructs an element and scatters its members into the columns
+        template <typename... Args>
+        void insert(size_type index, Args&&... args) {
+            if (slots_.contains(index)) {
+                return;
+            }
+
+            grow(slots_.size() + 1);
+
+            slots_.insert(index);
+
+            store(slots_.size() - 1, type(spark::forward<Args>(args)...));
+        }
+
+        // @brief overwrites every member of a contained element
+        void set(size_type index, const type& value) {
+            store(slots_.position(index), value);
+        }
+
+        // @brief removes every element and releases the columns
+        void clear() {
+            slots_.clear();
+            release();
+        }
+
+        // @brief allocates space for at least the provided number of elements
+        void reserve(size_type capacity) {
+            slots_.reserve(capacity);
+            grow(capacity);
+        }
+
+        void remove(size_type index) {
+            if (!slots_.contains(index)) {
+                return;
+            }
+
+            size_type position = slots_.position(index);
+            size_type last = slots_.size() - 1;
+
+            if (position != last) {
+                (copyField<Ms>(position, last), ...);
+            }
+
+            slots_.remove(index);
+        }
+
+        // @brief exchanges the dense positions of two contained elements
+        void swap(size_type a, size_type b) {
+            size_type positionA = slots_.position(a);
+            size_type positionB = slots_.position(b);
+
+            if (positionA == positionB) {
+                return;
+            }
+
+            (swapField<Ms>(positionA, positionB), ...);
+
+            slots_.swap(a, b);
+        }
+
+        // @brief reorders elements to follow the order of another set
+        // @note shared indices come first in the other set's order, the rest follow in no particular order
+        template <typename O>
+        void sort_as(const O& other) {
+            size_type position = 0;
+
+            for (size_type index : other.indices()) {
+                if (contains(index)) {
+                    swap(index, slots_.indices()[position++]);
+                }
+            }
+        }
+
+        [[nodiscard]] bool contains(size_type index) const {
+            return slots_.contains(index);
+        }
+
+        // @brief gathers a copy of a contained element
+        [[nodiscard]] const type get(size_type index) const {
+            return at(slots_.position(index));
+        }
+
+        // @brief gathers a copy of the element at a dense position
+        [[nodiscard]] const type at(size_type position) const {
+            type value{};
+
+            ((value.*Ms = column<Ms>()[position]), ...);
+
+            return value;
+        }
+
+        // @brief provides a single member of a contained element
+        template <auto M>
+        [[nodiscard]] member_type<M>& field(size_type index) {
+            return column<M>()[slots_.position(index)];
+        }
+
+        template <auto M>
+        [[nodiscard]] const member_type<M>& field(size_type index) const {
+            return column<M>()[slots_.position(index)];
+        }
+
+        // @brief provides one member of every element, in dense order
+        template <auto M>
+        [[nodiscard]] span<member_type<M>, size_type> column() {
+            static_assert(fieldIndex<M>() < field_count, "member is not a field of this set");
+
+            if (columns_.empty()) {
+                return span<member_type<M>, size_type>(nullptr, 0);
+            }
+
+            return span<member_type<M>, size_type>(reinterpret_cast<member_type<M>*>(columns_[fieldIndex<M>()]), slots_.size());
+        }
+
+        template <auto M>
+        [[nodiscard]] span<const member_type<M>, size_type> column() const {
+            static_assert(fieldIndex<M>() < field_count, "member is not a field of this set");
+
+            if (columns_.empty()) {
+                return span<const member_type<M>, size_type>(nullptr, 0);
+            }
+
+            return span<const member_type<M>, size_type>(reinterpret_cast<const member_type<M>*>(columns_[fieldIndex<M>()]), slots_.size());
+        }
+
+        // @brief gives the dense position of a contained element
+        [[nodiscard]] size_type position(size_type index) const {
+            return slots_.position(index);
+        }
+
+        [[nodiscard]] size_type size() const {
+            return slots_.size();
+        }
+
+        // @brief gives the number of elements that fit before the next allocation
+        [[nodiscard]] size_type capacity() const {
+            return min(capacity_, slots_.capacity());
+        }
+
+        [[nodiscard]] bool empty() const {
+            return slots_.empty();
+        }
+
+        // @brief provides the sparse index of every element, in dense order
+        [[nodiscard]] span<const size_type> indices() const {
+            return slots_.indices();
+        }
+
+    private:
+        struct slot {};
+
+        // @brief gives the position of a member within Ms
+        template <auto M>
+        static consteval uint64 fieldIndex() {
+            uint64 index = 0;
+            bool found = false;
+
+            ((found = found || is_same<soa_fields<M>, soa_fields<Ms>>, index += found ? 0 : 1), ...);
+
+            return index;
+        }
+
+        void store(size_type position, const type& value) {
+            ((column<Ms>()[position] = value.*Ms), ...);
+        }
+
+        template <auto M>
+        void copyField(size_type target, size_type source) {
+            auto data = column<M>();
+
+            data[target] = data[source];
+        }
+
+        template <auto M>
+        void swapField(size_type a, size_type b) {
+            auto data = column<M>();
+
+            member_type<M> held = data[a];
+            data[a] = data[b];
+            data[b] = held;
+        }
+
+        // @brief reallocates every column to fit at least the provided number of elements
+        void grow(size_type capacity) {
+            if (capacity <= capacity_) {
+                return;
+            }
+
+            capacity = max(capacity, double_growth_policy::expand(capacity_));
+
+            uint64 sizes[] = {sizeof(member_type<Ms>)...};
+
+            if (columns_.empty()) {
+                columns_.resize(field_count, nullptr);
+            }
+
+            for (uint64 i = 0; i < field_count; i++) {
+                uint8* column = static_cast<uint8*>(operator new(sizes[i] * capacity, std::align_val_t{column_alignment}));
+
+                if (columns_[i] != nullptr) {
+                    std::memcpy(column, columns_[i], sizes[i] * slots_.size());
+                    operator delete(columns_[i], std::align_val_t{column_alignment});
+                }
+
+                columns_[i] = column;
+            }
+
+            capacity_ = capacity;
+        }
+
+        void copyColumns(const soa_set& other) {
+            if (other.slots_.empty()) {
+                return;
+            }
+
+            grow(other.slots_.size());
+
+            uint64 sizes[] = {sizeof(member_type<Ms>)...};
+
+            for (uint64 i = 0; i < field_count; i++) {
+                std::memcpy(columns_[i], other.columns_[i], sizes[i] * other.slots_.size());
+            }
+        }
+
+        void release() {
+            for (uint8* column : columns_) {
+                operator delete(column, std::align_val_t{column_alignment});
+            }
+
+            columns_.clear();
+            capacity_ = 0;
+        }
+
+        sparse_set<slot, size_type> slots_;
+        list<uint8*, size_type> columns_;
+        size_type capacity_ = 0;
+    };
+}
@@ -37,6 +37,8 @@ namespace spark {
         span& operator=(const span& other) {
             data_ = other.data_;
             size_ = other.size_;
+
+            return *this;
         }
 
         span& operator=(span&& other) {
@@ -45,6 +47,8 @@ namespace spark {
 
             other.data_ = nullptr;
             other.size_ = 0;
+
+            return *this;
         }
 
         type& operator[](size_type index) {
@@ -59,14 +63,14 @@ namespace spark {
         // @param the offset into this span to start from
         // @param the size of the product span
         span subspan(size_type offset, size_type size) {
-            return span<T>(data_ + offset, size);
+            return span(data_ + offset, size);
         }
 
         // @brief provides a span over this span
         // @param the offset into this span to start from
         // @param the size of the product span
         span subspan(size_type offset, size_type size) const {
-            return span<T>(data_ + offset, size);
+            return span(data_ + offset, size);
         }
 
         // @brief sorts elements with a provided algorithm and condition
@@ -86,6 +90,16 @@ namespace spark {
             data_[b] = temporary;
         }
 
+        // @brief gives the number of elements in the span
+        size_type size() const {
+            return size_;
+        }
+
+        // @brief checks if the span has no elements
+        bool empty() const {
+            return size_ == 0;
+        }
+
         // @brief checks if the span is currently viewing valid memory
         bool valid() const {
             return data_ != nullptr && size_ > 0;
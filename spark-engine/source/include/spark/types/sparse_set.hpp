@@ -1,18 +1,38 @@
 #pragma once
 
+#include <cstring>
+
 #include <spark/types/core.hpp>
 #include <spark/types/list.hpp>
+#include <spark/types/segmented_list.hpp>
 #include <spark/types/traits.hpp>
 
+#include <spark/utilities/sorting.hpp>
+
 namespace spark {
-    template <typename T, typename U = uint64>
+    // @brief maps sparse indices to densely packed elements
+    // @note the sparse array is split into fixed-size pages that are only allocated once an index lands in them
+    // @note empty types store no elements, every index shares a single static instance
+    // @note V keeps an added and a changed tick next to every element
+    // @note P stores elements in a segmented_list, so they keep their address as the set grows, at the cost of data() and contiguous iteration
+    template <typename T, typename U = uint64, bool V = false, bool P = false>
     requires(is_unsigned<U>)
     class sparse_set {
     public:
         using type = T;
         using size_type = U;
 
+        // @brief when an element was added and last changed
+        struct ticks {
+            size_type added;
+            size_type changed;
+        };
+
         static constexpr size_type dead_index = static_cast<size_type>(-1);
+        static constexpr size_type page_size = 4096;
+        static constexpr bool stores_elements = !is_empty<type>;
+        static constexpr bool stores_ticks = V;
+        static constexpr bool contiguous = !P;
 
         sparse_set() = default;
         ~sparse_set() = default;
@@ -25,17 +45,76 @@ namespace spark {
 
         template <typename... Args>
         type& insert(size_type index, Args&&... args) {
-            if (index >= sparse_.size()) {
-                sparse_.resize(index + 1, dead_index);
-            }
+            size_type& slot = assure(index);
 
-            if (sparse_[index] == dead_index) {
-                sparse_[index] = dense_.size();
-                dense_.emplace(forward<Args>(args)...);
+            if (slot == dead_index) {
+                slot = denseTable_.size();
                 denseTable_.emplace(index);
+
+                if constexpr (stores_elements) {
+                    dense_.emplace(spark::forward<Args>(args)...);
+                }
+
+                if constexpr (stores_ticks) {
+                    ticks_.emplace(ticks{0, 0});
+                }
             }
 
-            return dense_[sparse_[index]];
+            return at(slot);
+        }
+
+        // @brief replaces every element with default elements at the provided indices
+        // @note meant for bulk loading, the elements and ticks are then copied over through copy_from() and tick_data()
+        // @note contiguous trivially copyable elements and the ticks are left uninitialized, as the copy overwrites them anyway
+        void assign(const size_type* indices, size_type count) {
+            clear();
+
+            denseTable_.resize_uninitialized(count);
+
+            if constexpr (stores_elements) {
+                if constexpr (contiguous && is_trivially_copyable<type>) {
+                    dense_.resize_uninitialized(count);
+                }
+                else {
+                    dense_.resize(count);
+                }
+            }
+
+            if constexpr (stores_ticks) {
+                ticks_.resize_uninitialized(count);
+            }
+
+            for (size_type i = 0; i < count; i++) {
+                denseTable_[i] = indices[i];
+                assure(indices[i]) = i;
+            }
+        }
+
+        // @brief removes every element and releases the sparse pages
+        void clear() {
+            if constexpr (stores_elements) {
+                dense_.clear();
+            }
+
+            if constexpr (stores_ticks) {
+                ticks_.clear();
+            }
+
+            denseTable_.clear();
+            pages_.clear();
+        }
+
+        // @brief allocates space for at least the provided number of elements
+        void reserve(size_type capacity) {
+            if constexpr (stores_elements) {
+                dense_.reserve(capacity);
+            }
+
+            if constexpr (stores_ticks) {
+                ticks_.reserve(capacity);
+            }
+
+            denseTable_.reserve(capacity);
         }
 
         void remove(size_type index) {
@@ -43,62 +122,291 @@ namespace spark {
                 return;
             }
 
-            size_type denseIndex = sparse_[index];
-            size_type lastDense = dense_.size() - 1;
+            size_type denseIndex = sparse(index);
+            size_type lastDense = denseTable_.size() - 1;
 
             if (denseIndex != lastDense) {
-                dense_.swap(denseIndex, lastDense);
-                denseTable_.swap(denseIndex, lastDense);
+                swapAt(denseIndex, lastDense);
 
                 size_type movedIndex = denseTable_[denseIndex];
-                sparse_[movedIndex] = denseIndex;
+                sparse(movedIndex) = denseIndex;
             }
 
-            sparse_[index] = dead_index;
+            sparse(index) = dead_index;
+
+            if constexpr (stores_elements) {
+                dense_.pop();
+            }
+
+            if constexpr (stores_ticks) {
+                ticks_.pop();
+            }
 
-            dense_.pop();
             denseTable_.pop();
         }
 
+        // @brief exchanges the dense positions of two contained elements
+        void swap(size_type a, size_type b) {
+            size_type denseA = sparse(a);
+            size_type denseB = sparse(b);
+
+            if (denseA == denseB) {
+                return;
+            }
+
+            swapAt(denseA, denseB);
+
+            sparse(a) = denseB;
+            sparse(b) = denseA;
+        }
+
+        // @brief sorts elements with a provided algorithm and condition, keeping every index mapped to its element
+        // @note the algorithm orders lightweight entries, so each element is only moved once
+        template <typename S, typename C>
+        void sort() {
+            struct entry {
+                type* value;
+                size_type position;
+            };
+
+            struct condition {
+                static bool compare(entry& a, entry& b) {
+                    return C::compare(*a.value, *b.value);
+                }
+            };
+
+            list<entry, size_type> order;
+            order.reserve(denseTable_.size());
+
+            for (size_type i = 0; i < denseTable_.size(); i++) {
+                order.emplace(entry{&at(i), i});
+            }
+
+            order.template sort<S, condition>();
+
+            // @note follows each cycle of the permutation, so position i ends up with the element order[i] names
+            for (size_type i = 0; i < order.size(); i++) {
+                size_type current = i;
+
+                while (order[current].position != i) {
+                    size_type next = order[current].position;
+
+                    swapAt(current, next);
+
+                    order[current].position = current;
+                    current = next;
+                }
+
+                order[current].position = current;
+            }
+
+            for (size_type i = 0; i < denseTable_.size(); i++) {
+                sparse(denseTable_[i]) = i;
+            }
+        }
+
+        // @brief reorders elements to follow the order of another set
+        // @note shared indices come first in the other set's order, the rest follow in no particular order
+        template <typename O>
+        void sort_as(const O& other) {
+            size_type position = 0;
+
+            for (size_type index : other.indices()) {
+                if (contains(index)) {
+                    swap(index, denseTable_[position++]);
+                }
+            }
+        }
+
+        // @note an unallocated page reads as empty without touching memory
         [[nodiscard]] bool contains(size_type index) const {
-            return index < sparse_.size() && sparse_[index] != dead_index;
+            size_type page = index / page_size;
+
+            return page < pages_.size() && !pages_[page].empty() && pages_[page][index % page_size] != dead_index;
         }
 
         [[nodiscard]] type& get(size_type index) {
-            return dense_[sparse_[index]];
+            return at(sparse(index));
         }
 
         [[nodiscard]] const type& get(size_type index) const {
-            return dense_[sparse_[index]];
+            return at(sparse(index));
+        }
+
+        // @brief provides the element at a dense position
+        [[nodiscard]] type& at(size_type position) {
+            if constexpr (stores_elements) {
+                return dense_[position];
+            }
+            else {
+                return instance_;
+            }
+        }
+
+        [[nodiscard]] const type& at(size_type position) const {
+            if constexpr (stores_elements) {
+                return dense_[position];
+            }
+            else {
+                return instance_;
+            }
+        }
+
+        // @brief records that a contained element was added at the provided tick
+        void stamp(size_type index, size_type tick)
+        requires(stores_ticks) {
+            ticks_[sparse(index)] = ticks{tick, tick};
+        }
+
+        // @brief records that a contained element changed at the provided tick
+        void touch(size_type index, size_type tick)
+        requires(stores_ticks) {
+            ticks_[sparse(index)].changed = tick;
+        }
+
+        // @brief provides when a contained element was added and last changed
+        [[nodiscard]] const ticks& ticks_of(size_type index) const
+        requires(stores_ticks) {
+            return ticks_[sparse(index)];
+        }
+
+        // @brief provides the ticks of every element, in dense order
+        [[nodiscard]] ticks* tick_data()
+        requires(stores_ticks) {
+            return ticks_.data();
+        }
+
+        [[nodiscard]] const ticks* tick_data() const
+        requires(stores_ticks) {
+            return ticks_.data();
+        }
+
+        // @brief gives the dense position of a contained element
+        [[nodiscard]] size_type position(size_type index) const {
+            return sparse(index);
         }
 
         [[nodiscard]] size_type size() const {
-            return dense_.size();
+            return denseTable_.size();
+        }
+
+        // @brief gives the number of elements that fit before the next allocation
+        [[nodiscard]] size_type capacity() const {
+            return denseTable_.capacity();
         }
 
         [[nodiscard]] bool empty() const {
-            return dense_.empty();
+            return denseTable_.empty();
+        }
+
+        // @brief provides the sparse index of every element, in dense order
+        [[nodiscard]] span<const size_type> indices() const {
+            return denseTable_;
+        }
+
+        [[nodiscard]] type* data()
+        requires(stores_elements && contiguous) {
+            return dense_.data();
+        }
+
+        [[nodiscard]] const type* data() const
+        requires(stores_elements && contiguous) {
+            return dense_.data();
         }
 
-        type* begin() {
+        // @brief copies every element into contiguous memory, in dense order
+        void copy_to(type* destination) const
+        requires(stores_elements && is_trivially_copyable<T>) {
+            if constexpr (contiguous) {
+                if (!dense_.empty()) {
+                    std::memcpy(static_cast<void*>(destination), dense_.data(), sizeof(type) * dense_.size());
+                }
+            }
+            else {
+                dense_.copy_to(destination);
+            }
+        }
+
+        // @brief overwrites every element from contiguous memory, in dense order
+        void copy_from(const type* source)
+        requires(stores_elements && is_trivially_copyable<T>) {
+            if constexpr (contiguous) {
+                if (!dense_.empty()) {
+                    std::memcpy(static_cast<void*>(dense_.data()), source, sizeof(type) * dense_.size());
+                }
+            }
+            else {
+                dense_.copy_from(source);
+            }
+        }
+
+        auto begin()
+        requires(stores_elements) {
             return dense_.begin();
         }
 
-        type* end() {
+        auto end()
+        requires(stores_elements) {
             return dense_.end();
         }
 
-        const type* begin() const {
+        auto begin() const
+        requires(stores_elements) {
             return dense_.begin();
         }
 
-        const type* end() const {
+        auto end() const
+        requires(stores_elements) {
             return dense_.end();
         }
 
     private:
-        list<type, size_type> dense_;
+        struct no_elements {};
+
+        // @brief exchanges two dense positions without fixing up their sparse slots
+        void swapAt(size_type a, size_type b) {
+            if constexpr (stores_elements) {
+                dense_.swap(a, b);
+            }
+
+            if constexpr (stores_ticks) {
+                ticks_.swap(a, b);
+            }
+
+            denseTable_.swap(a, b);
+        }
+
+        // @brief provides the sparse slot of an index whose page is allocated
+        [[nodiscard]] size_type& sparse(size_type index) {
+            return pages_[index / page_size][index % page_size];
+        }
+
+        [[nodiscard]] const size_type& sparse(size_type index) const {
+            return pages_[index / page_size][index % page_size];
+        }
+
+        // @brief provides the sparse slot of an index, allocating its page if needed
+        size_type& assure(size_type index) {
+            size_type page = index / page_size;
+
+            if (page >= pages_.size()) {
+                pages_.resize(page + 1);
+            }
+
+            if (pages_[page].empty()) {
+                pages_[page].resize(page_size, dead_index);
+            }
+
+            return pages_[page][index % page_size];
+        }
+
+        using dense_type = conditional<contiguous, list<type, size_type>, segmented_list<type, size_type>>;
+
+        [[no_unique_address]] conditional<stores_elements, dense_type, no_elements> dense_;
         list<size_type, size_type> denseTable_;
-        list<size_type, size_type> sparse_;
+        [[no_unique_address]] conditional<stores_ticks, list<ticks, size_type>, no_elements> ticks_;
+        list<list<size_type, size_type>, size_type> pages_;
+
+        inline static type instance_{};
     };
 }
\ No newline at end of file
@@ -66,7 +66,45 @@ namespace spark {
     template <>
     inline constexpr bool is_unsigned<char> = false;
 
+    template <typename, typename>
+    inline constexpr bool is_same = false;
+
+    template <typename T>
+    inline constexpr bool is_same<T, T> = true;
+
+    // @brief true for class types without non-static data members, such as tag components
+    template <typename T>
+    inline constexpr bool is_empty = __is_empty(T);
+
+    // @brief true for types that can be copied byte for byte
+    template <typename T>
+    inline constexpr bool is_trivially_copyable = __is_trivially_copyable(T);
+
+    // @brief true for types whose destructor does nothing
+    template <typename T>
+    inline constexpr bool is_trivially_destructible = __has_trivial_destructor(T);
+
+    // @brief true for types that can be moved to another address byte for byte, without destroying the original
+    // @note covers trivially copyable types, specialise it for types that only own memory through pointers to elsewhere
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable = is_trivially_copyable<T>;
+
     namespace detail {
+        template <typename T, typename...>
+        struct first_selector {
+            using type = T;
+        };
+
+        template <bool B, typename T, typename F>
+        struct conditional_selector {
+            using type = T;
+        };
+
+        template <typename T, typename F>
+        struct conditional_selector<false, T, F> {
+            using type = F;
+        };
+
         template <class T>
         struct reference_remover {
             using type = T;
@@ -81,8 +119,44 @@ namespace spark {
         struct reference_remover<T&&> {
             using type = T;
         };
+
+        template <class T>
+        struct const_remover {
+            using type = T;
+        };
+
+        template <class T>
+        struct const_remover<const T> {
+            using type = T;
+        };
+
+        template <typename T>
+        struct member_splitter;
+
+        template <typename T, typename O>
+        struct member_splitter<T O::*> {
+            using type = T;
+            using owner = O;
+        };
     }
 
     template <typename T>
     using remove_reference = detail::reference_remover<T>::type;
-}
\ No newline at end of file
+
+    template <typename T>
+    using remove_const = detail::const_remover<T>::type;
+
+    template <typename... Ts>
+    using first_of = detail::first_selector<Ts...>::type;
+
+    template <bool B, typename T, typename F>
+    using conditional = detail::conditional_selector<B, T, F>::type;
+
+    // @brief the type of the data member a member pointer names
+    template <auto M>
+    using member_type = detail::member_splitter<decltype(M)>::type;
+
+    // @brief the class a member pointer belongs to
+    template <auto M>
+    using member_owner = detail::member_splitter<decltype(M)>::owner;
+}
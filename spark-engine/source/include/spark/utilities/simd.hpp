@@ -0,0 +1,167 @@
+#pragma once
+
+#include <spark/types/core.hpp>
+#include <spark/types/traits.hpp>
+
+namespace spark {
+    // @brief widest vector register the build targets, in bytes
+    // @note chosen at compile time from the enabled instruction sets, 0 when only scalar code is available
+#if defined(__AVX512F__)
+    inline constexpr uint64 simd_bytes = 64;
+#elif defined(__AVX2__) || defined(__AVX__)
+    inline constexpr uint64 simd_bytes = 32;
+#elif defined(__SSE2__) || defined(__ARM_NEON) || defined(_M_X64) || defined(_M_ARM64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    inline constexpr uint64 simd_bytes = 16;
+#else
+    inline constexpr uint64 simd_bytes = 0;
+#endif
+
+    // @brief number of T that fill one vector register, at least 1
+    template <typename T>
+    inline constexpr uint64 simd_width = simd_bytes / sizeof(T) > 0 ? simd_bytes / sizeof(T) : 1;
+
+    namespace detail {
+#if defined(_MSC_VER) && !defined(__clang__)
+        // @brief W lanes held in a plain array, for compilers without vector extensions
+        // @note operators loop over the lanes, which the optimiser vectorises where it can
+        template <typename T, uint64 W, uint64 A>
+        struct alignas(A) simd_array {
+            T lanes[W];
+
+            [[nodiscard]] constexpr T& operator[](uint64 index) {
+                return lanes[index];
+            }
+
+            [[nodiscard]] constexpr const T& operator[](uint64 index) const {
+                return lanes[index];
+            }
+
+            [[nodiscard]] static constexpr simd_array broadcast(T value) {
+                simd_array result;
+
+                for (uint64 i = 0; i < W; i++) {
+                    result.lanes[i] = value;
+                }
+
+                return result;
+            }
+
+            // @brief combines two sets of lanes one lane at a time
+            template <typename F>
+            [[nodiscard]] constexpr simd_array zip(const simd_array& other, F&& operation) const {
+                simd_array result;
+
+                for (uint64 i = 0; i < W; i++) {
+                    result.lanes[i] = static_cast<T>(operation(lanes[i], other.lanes[i]));
+                }
+
+                return result;
+            }
+
+            [[nodiscard]] constexpr simd_array operator-() const {
+                return broadcast(T{}) - *this;
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator+(const simd_array& a, const simd_array& b) {
+                return a.zip(b, [](T x, T y) { return x + y; });
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator-(const simd_array& a, const simd_array& b) {
+                return a.zip(b, [](T x, T y) { return x - y; });
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator*(const simd_array& a, const simd_array& b) {
+                return a.zip(b, [](T x, T y) { return x * y; });
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator/(const simd_array& a, const simd_array& b) {
+                return a.zip(b, [](T x, T y) { return x / y; });
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator+(const simd_array& a, T b) {
+                return a + broadcast(b);
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator-(const simd_array& a, T b) {
+                return a - broadcast(b);
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator*(const simd_array& a, T b) {
+                return a * broadcast(b);
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator/(const simd_array& a, T b) {
+                return a / broadcast(b);
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator+(T a, const simd_array& b) {
+                return broadcast(a) + b;
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator-(T a, const simd_array& b) {
+                return broadcast(a) - b;
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator*(T a, const simd_array& b) {
+                return broadcast(a) * b;
+            }
+
+            [[nodiscard]] friend constexpr simd_array operator/(T a, const simd_array& b) {
+                return broadcast(a) / b;
+            }
+
+            template <typename V>
+            constexpr simd_array& operator+=(const V& other) {
+                return *this = *this + other;
+            }
+
+            template <typename V>
+            constexpr simd_array& operator-=(const V& other) {
+                return *this = *this - other;
+            }
+
+            template <typename V>
+            constexpr simd_array& operator*=(const V& other) {
+                return *this = *this * other;
+            }
+
+            template <typename V>
+            constexpr simd_array& operator/=(const V& other) {
+                return *this = *this / other;
+            }
+        };
+
+        template <typename T, uint64 W>
+        struct simd_selector {
+            using type = simd_array<T, W, sizeof(T) * W>;
+        };
+
+        template <typename T, uint64 W>
+        struct unaligned_simd_selector {
+            using type = simd_array<T, W, alignof(T)>;
+        };
+#else
+        template <typename T, uint64 W>
+        struct simd_selector {
+            typedef T type __attribute__((vector_size(sizeof(T) * W)));
+        };
+
+        template <typename T, uint64 W>
+        struct unaligned_simd_selector {
+            typedef T type __attribute__((vector_size(sizeof(T) * W), aligned(alignof(T)), may_alias));
+        };
+#endif
+    }
+
+    // @brief W lanes of an arithmetic type, operated on with the usual operators
+    // @note lowered to SSE, AVX2 or AVX-512 instructions as enabled, wider vectors are split and a single lane is plain scalar code
+    // @note built on the GCC and Clang vector extensions, MSVC gets a plain array of lanes with the arithmetic operators instead
+    template <typename T, uint64 W>
+    requires(is_arithmetic<T> && W > 0 && (W & (W - 1)) == 0)
+    using simd = detail::simd_selector<T, W>::type;
+
+    // @brief W lanes laid over existing memory, which only has to be aligned for T
+    template <typename T, uint64 W>
+    requires(is_arithmetic<T> && W > 0 && (W & (W - 1)) == 0)
+    using unaligned_simd = detail::unaligned_simd_selector<T, W>::type;
+}
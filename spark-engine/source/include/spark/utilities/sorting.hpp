@@ -1,5 +1,6 @@
 #pragma once
 
+#include <new>
 #include <random>
 
 #include <spark/types/core.hpp>
@@ -19,10 +20,10 @@ namespace spark {
             for (spark::uint64 i = 0; i < size; i++) {
                 for (spark::uint64 j = 0; j + 1 < size - i; j++) {
                     if (C::compare(data[j + 1], data[j])) {
-                        T temporary = move(data[j]);
+                        T temporary = spark::move(data[j]);
 
-                        data[j] = move(data[j + 1]);
-                        data[j + 1] = move(temporary);
+                        data[j] = spark::move(data[j + 1]);
+                        data[j + 1] = spark::move(temporary);
                     }
                 }
             }
@@ -47,10 +48,10 @@ namespace spark {
                     }
                 }
                 if (i != minIndex) {
-                    T temporary = move(data[i]);
+                    T temporary = spark::move(data[i]);
 
-                    data[i] = move(data[minIndex]);
-                    data[minIndex] = move(temporary);
+                    data[i] = spark::move(data[minIndex]);
+                    data[minIndex] = spark::move(temporary);
                 }
             }
         }
@@ -66,16 +67,78 @@ namespace spark {
             }
 
             for (spark::uint64 i = 1; i < size; i++) {
-                T key = move(data[i]);
+                T key = spark::move(data[i]);
 
                 spark::uint64 j = i;
 
                 while (j > 0 && C::compare(key, data[j - 1])) {
-                    data[j] = move(data[j - 1]);
+                    data[j] = spark::move(data[j - 1]);
                     --j;
                 }
 
-                data[j] = move(key);
+                data[j] = spark::move(key);
+            }
+        }
+    };
+
+    // @brief divide-and-conquer sorting algorithm that merges sorted halves
+    // @note stable, O(n log n) in every case, allocates a buffer of half the range
+    // @note ranges of up to 16 elements are finished with insertion sort, and halves already in order skip the merge
+    struct merge_sort {
+        template <typename T, typename C>
+        static void sort(T* data, spark::uint64 size) {
+            if (size < 2) {
+                return;
+            }
+
+            T* buffer = static_cast<T*>(::operator new(sizeof(T) * (size / 2), std::align_val_t{alignof(T)}));
+
+            sortRange<T, C>(data, size, buffer);
+
+            ::operator delete(buffer, std::align_val_t{alignof(T)});
+        }
+
+    private:
+        template <typename T, typename C>
+        static void sortRange(T* data, spark::uint64 size, T* buffer) {
+            if (size <= 16) {
+                insertion_sort::sort<T, C>(data, size);
+                return;
+            }
+
+            spark::uint64 middle = size / 2;
+
+            sortRange<T, C>(data, middle, buffer);
+            sortRange<T, C>(data + middle, size - middle, buffer);
+
+            if (!C::compare(data[middle], data[middle - 1])) {
+                return;
+            }
+
+            for (spark::uint64 i = 0; i < middle; i++) {
+                new (static_cast<void*>(&buffer[i])) T(spark::move(data[i]));
+            }
+
+            spark::uint64 left = 0;
+            spark::uint64 right = middle;
+            spark::uint64 output = 0;
+
+            // @note takes from the right half only when strictly smaller, which keeps equal elements in order
+            while (left < middle && right < size) {
+                if (C::compare(data[right], buffer[left])) {
+                    data[output++] = spark::move(data[right++]);
+                }
+                else {
+                    data[output++] = spark::move(buffer[left++]);
+                }
+            }
+
+            while (left < middle) {
+                data[output++] = spark::move(buffer[left++]);
+            }
+
+            for (spark::uint64 i = 0; i < middle; i++) {
+                buffer[i].~T();
             }
         }
     };
@@ -98,9 +161,9 @@ namespace spark {
 
                 for (spark::uint64 i = start; i < end; i++) {
                     if (C::compare(data[i + 1], data[i])) {
-                        T temporary = move(data[i]);
-                        data[i] = move(data[i + 1]);
-                        data[i + 1] = move(temporary);
+                        T temporary = spark::move(data[i]);
+                        data[i] = spark::move(data[i + 1]);
+                        data[i + 1] = spark::move(temporary);
                         swapped = true;
                     }
                 }
@@ -114,9 +177,9 @@ namespace spark {
 
                 for (spark::uint64 i = end; i > start; i--) {
                     if (C::compare(data[i], data[i - 1])) {
-                        T temporary = move(data[i]);
-                        data[i] = move(data[i - 1]);
-                        data[i - 1] = move(temporary);
+                        T temporary = spark::move(data[i]);
+                        data[i] = spark::move(data[i - 1]);
+                        data[i - 1] = spark::move(temporary);
                         swapped = true;
                     }
                 }